@@ -506,6 +506,13 @@ top-symbols: build
 	echo "###########################################"
 endif
 
+ifeq ($(strip $(RGB_MATRIX_ENABLE)),yes)
+all: rgb-matrix-arena
+check-size: rgb-matrix-arena
+rgb-matrix-arena: build
+	$(NM) -Crtd --size-sort $(BUILD_DIR)/$(TARGET).elf | sed -n -e 's#^0*\([0-9][0-9]*\) [bBdD] rgb_matrix_effect_arena.*#RGB Matrix effect state: \1 bytes of RAM#p'
+endif
+
 include $(BUILDDEFS_PATH)/show_options.mk
 include $(BUILDDEFS_PATH)/common_rules.mk
 
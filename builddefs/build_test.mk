@@ -35,6 +35,15 @@ $(GTEST_OUTPUT)_INC := $(GTEST_INC) $(GTEST_INTERNAL_INC)
 LDFLAGS += -lstdc++ -lpthread -shared-libgcc
 CREATE_MAP := no
 
+# Share the objects that come out the same between test suites, such as most
+# of the quantum core, instead of compiling them again for every suite
+TEST_OBJECT_CACHE ?= yes
+ifeq ($(strip $(TEST_OBJECT_CACHE)), yes)
+    ifeq ($(filter-out no,$(USE_CCACHE)),)
+        CC_PREFIX ?= util/test_object_cache.sh $(BUILD_DIR)/test_cache
+    endif
+endif
+
 VPATH += \
 	$(LIB_PATH)/googletest \
 	$(LIB_PATH)/googlemock \
@@ -60,8 +69,10 @@ include $(BUILDDEFS_PATH)/common_features.mk
 include $(BUILDDEFS_PATH)/generic_features.mk
 include $(PLATFORM_PATH)/common.mk
 include $(TMK_PATH)/protocol.mk
+include $(QUANTUM_PATH)/audio/tests/rules.mk
 include $(QUANTUM_PATH)/debounce/tests/rules.mk
 include $(QUANTUM_PATH)/encoder/tests/rules.mk
+include $(QUANTUM_PATH)/pointing_device/tests/rules.mk
 include $(QUANTUM_PATH)/sequencer/tests/rules.mk
 include $(QUANTUM_PATH)/wear_leveling/tests/rules.mk
 include $(QUANTUM_PATH)/logging/print.mk
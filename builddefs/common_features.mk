@@ -52,6 +52,9 @@ ifeq ($(strip $(AUDIO_ENABLE)), yes)
             OPT_DEFS += -DAUDIO_DRIVER_DAC
         else ifeq ($(strip $(AUDIO_DRIVER)), dac_additive)
             OPT_DEFS += -DAUDIO_DRIVER_DAC
+        else ifeq ($(strip $(AUDIO_DRIVER)), dac_synth)
+            OPT_DEFS += -DAUDIO_DRIVER_DAC
+            SRC += $(QUANTUM_DIR)/audio/audio_synth.c
         ## stm32f2 and above have a usable DAC unit, f1 do not, and need to use pwm instead
         else ifeq ($(strip $(AUDIO_DRIVER)), pwm_software)
             OPT_DEFS += -DAUDIO_DRIVER_PWM
@@ -91,14 +94,17 @@ ifeq ($(MUSIC_ENABLE), yes)
     SRC += $(QUANTUM_DIR)/process_keycode/process_music.c
 endif
 
-VALID_STENO_PROTOCOL_TYPES := geminipr txbolt all
+VALID_STENO_PROTOCOL_TYPES := geminipr txbolt hid all
 STENO_PROTOCOL ?= all
 ifeq ($(strip $(STENO_ENABLE)), yes)
     ifeq ($(filter $(STENO_PROTOCOL),$(VALID_STENO_PROTOCOL_TYPES)),)
         $(call CATASTROPHIC_ERROR,Invalid STENO_PROTOCOL,STENO_PROTOCOL="$(STENO_PROTOCOL)" is not a valid stenography protocol)
     else
         OPT_DEFS += -DSTENO_ENABLE
-        VIRTSER_ENABLE ?= yes
+
+        ifneq ($(strip $(STENO_PROTOCOL)), hid)
+            VIRTSER_ENABLE ?= yes
+        endif
 
         ifeq ($(strip $(STENO_PROTOCOL)), geminipr)
             OPT_DEFS += -DSTENO_ENABLE_GEMINI
@@ -106,10 +112,14 @@ ifeq ($(strip $(STENO_ENABLE)), yes)
         ifeq ($(strip $(STENO_PROTOCOL)), txbolt)
             OPT_DEFS += -DSTENO_ENABLE_BOLT
         endif
+        ifeq ($(strip $(STENO_PROTOCOL)), hid)
+            OPT_DEFS += -DSTENO_ENABLE_HID
+        endif
         ifeq ($(strip $(STENO_PROTOCOL)), all)
             OPT_DEFS += -DSTENO_ENABLE_ALL
             OPT_DEFS += -DSTENO_ENABLE_GEMINI
             OPT_DEFS += -DSTENO_ENABLE_BOLT
+            OPT_DEFS += -DSTENO_ENABLE_HID
         endif
 
         SRC += $(QUANTUM_DIR)/process_keycode/process_steno.c
@@ -136,6 +146,7 @@ ifeq ($(strip $(POINTING_DEVICE_ENABLE)), yes)
         VPATH += $(QUANTUM_DIR)/pointing_device
         SRC += $(QUANTUM_DIR)/pointing_device/pointing_device.c
         SRC += $(QUANTUM_DIR)/pointing_device/pointing_device_drivers.c
+        SRC += $(QUANTUM_DIR)/pointing_device/pointing_device_accel.c
         ifneq ($(strip $(POINTING_DEVICE_DRIVER)), custom)
             SRC += drivers/sensors/$(strip $(POINTING_DEVICE_DRIVER)).c
             OPT_DEFS += -DPOINTING_DEVICE_DRIVER_$(strip $(shell echo $(POINTING_DEVICE_DRIVER) | tr '[:lower:]' '[:upper:]'))
@@ -610,6 +621,7 @@ ifeq ($(strip $(VIA_ENABLE)), yes)
     DYNAMIC_KEYMAP_ENABLE := yes
     RAW_ENABLE := yes
     BOOTMAGIC_ENABLE := yes
+    CRC_ENABLE := yes
     SRC += $(QUANTUM_DIR)/via.c
     OPT_DEFS += -DVIA_ENABLE
 endif
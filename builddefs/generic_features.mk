@@ -29,7 +29,10 @@ GENERIC_FEATURES = \
     HAPTIC \
     KEY_LOCK \
     KEY_OVERRIDE \
+    LATENCY_TRACE \
     LEADER \
+    MATRIX_TRACE \
+    PROCESS_PROFILE \
     PROGRAMMABLE_BUTTON \
     SECURE \
     SPACE_CADET \
@@ -69,6 +69,7 @@ subcommands = [
     'qmk.cli.list.keyboards',
     'qmk.cli.list.keymaps',
     'qmk.cli.list.layouts',
+    'qmk.cli.matrix_trace',
     'qmk.cli.kle2json',
     'qmk.cli.multibuild',
     'qmk.cli.new.keyboard',
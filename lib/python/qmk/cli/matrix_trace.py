@@ -0,0 +1,29 @@
+"""Convert the switch matrix edges streamed to the console into a simulator trace.
+"""
+import sys
+
+from milc import cli
+
+import qmk.path
+from qmk.commands import dump_lines
+from qmk.matrix_trace import format_trace, parse_console
+
+
+@cli.argument('-o', '--output', arg_only=True, type=qmk.path.normpath, help='File to write to')
+@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.argument('filename', nargs='?', type=qmk.path.FileType('r'), arg_only=True, help='Console log to read, or - for stdin')
+@cli.subcommand('Convert a console log of MATRIX_TRACE_ENABLE output into a key simulator trace.')
+def matrix_trace(cli):
+    """Convert the `mtrace` lines of a console log into a key simulator trace.
+    """
+    log = cli.args.filename or sys.stdin
+    edges, dropped = parse_console(log)
+
+    if not edges:
+        cli.log.error('No matrix trace found, is MATRIX_TRACE_CONSOLE defined?')
+        return False
+
+    if dropped:
+        cli.log.warning(f'The keyboard dropped {dropped} edges, increase MATRIX_TRACE_BUFFER_SIZE to avoid gaps in the trace.')
+
+    dump_lines(cli.args.output, format_trace(edges), cli.args.quiet)
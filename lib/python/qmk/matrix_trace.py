@@ -0,0 +1,71 @@
+"""Functions for decoding the switch matrix edges recorded by quantum/matrix_trace.c.
+
+The decoded traces are written in the format replayed by the key simulator in tests/simulator: one `<time> <row> <col> <d|u>` line per edge, with the time in milliseconds.
+"""
+import re
+
+CONSOLE_LINE = re.compile(r'mtrace (\d+) (\d+) ([0-9A-Fa-f]+)\s*$')
+CONSOLE_DROPPED = re.compile(r'mtrace dropped (\d+)\s*$')
+
+
+def decode(data, rows, cols, time=0):
+    """Returns the `(time, row, col, pressed)` edges encoded in data.
+
+    `time` is the time of the edge recorded before the first one in data. Edges are read until data runs out, a partial edge at the end is ignored.
+    """
+    key_size = 1 if rows * cols <= 128 else 2
+    edges = []
+    i = 0
+
+    while True:
+        delta, shift = 0, 0
+        while i < len(data) and data[i] & 0x80:
+            delta |= (data[i] & 0x7F) << shift
+            shift += 7
+            i += 1
+
+        if i + key_size >= len(data):
+            break
+
+        delta |= data[i] << shift
+        key = int.from_bytes(data[i + 1:i + 1 + key_size], 'big')
+        pressed = bool(key & (0x80 << (8 * (key_size - 1))))
+        key &= ~(0x80 << (8 * (key_size - 1)))
+        i += 1 + key_size
+
+        time += delta
+        edges.append((time, key // cols, key % cols, pressed))
+
+    return edges
+
+
+def parse_console(lines):
+    """Returns the edges streamed in a console log, and the number of edges the keyboard had to drop.
+    """
+    edges = []
+    dropped = 0
+    time = 0
+
+    for line in lines:
+        match = CONSOLE_LINE.search(line)
+        if match:
+            rows, cols, data = int(match.group(1)), int(match.group(2)), bytes.fromhex(match.group(3))
+            decoded = decode(data, rows, cols, time)
+            if decoded:
+                time = decoded[-1][0]
+            edges.extend(decoded)
+            continue
+
+        match = CONSOLE_DROPPED.search(line)
+        if match:
+            dropped += int(match.group(1))
+
+    return edges, dropped
+
+
+def format_trace(edges):
+    """Returns the lines of a simulator trace holding edges, with the first edge at time 0.
+    """
+    start = edges[0][0] if edges else 0
+
+    return [f'{time - start} {row} {col} {"d" if pressed else "u"}' for time, row, col, pressed in edges]
@@ -0,0 +1,37 @@
+import qmk.matrix_trace
+
+# The console output of tests/matrix_trace with MATRIX_TRACE_CONSOLE defined
+CONSOLE_LOG = '''\
+Ψ Console Connected: Test Keyboard
+test:keyboard:1: mtrace 4 10 0080
+test:keyboard:1: mtrace 4 10 0A00
+test:keyboard:1: mtrace dropped 2
+test:keyboard:1: mtrace 4 10 AC0297
+test:keyboard:1: mtrace 4 10 0117
+'''
+
+
+def test_decode():
+    edges = qmk.matrix_trace.decode(bytes([0x00, 0x80, 0x0A, 0x00, 0xAC, 0x02, 0x97]), 4, 10)
+
+    assert edges == [(0, 0, 0, True), (10, 0, 0, False), (310, 2, 3, True)]
+
+
+def test_decode_large_matrix():
+    # More than 128 keys take two bytes per key
+    edges = qmk.matrix_trace.decode(bytes([0x05, 0x80, 0xC8, 0x07, 0x00, 0xC8]), 10, 21, 100)
+
+    assert edges == [(105, 9, 11, True), (112, 9, 11, False)]
+
+
+def test_decode_ignores_partial_edge():
+    edges = qmk.matrix_trace.decode(bytes([0x01, 0x81, 0xAC, 0x02]), 4, 10)
+
+    assert edges == [(1, 0, 1, True)]
+
+
+def test_parse_console():
+    edges, dropped = qmk.matrix_trace.parse_console(CONSOLE_LOG.splitlines())
+
+    assert dropped == 2
+    assert qmk.matrix_trace.format_trace(edges) == ['0 0 0 d', '10 0 0 u', '310 2 3 d', '311 2 3 u']
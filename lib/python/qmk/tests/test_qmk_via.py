@@ -0,0 +1,180 @@
+import qmk.via
+
+# 10 layers of a 6x21 matrix, two bytes per keycode
+KEYMAP_SIZE = 10 * 6 * 21 * 2
+
+
+class FakeViaKeyboard:
+    """Raw HID endpoint answering like quantum/via.c does.
+
+    Every report takes one USB frame (1ms for raw HID), in either direction, so `frames` is how long the transfer would have taken on the wire.
+    With `streaming`, an id_switch_matrix_delta report is queued ahead of every reply.
+    """
+    def __init__(self, bulk=True, drop=(), streaming=False):
+        self.keymap = bytearray(KEYMAP_SIZE)
+        self.bulk = bulk
+        self.drop = list(drop)
+        self.streaming = streaming
+        self.replies = []
+        self.frames = 0
+        self.round_trips = 0
+        self.data_reports = 0
+        self.transfer = None
+
+    def write(self, report):
+        assert len(report) == qmk.via.VIA_REPORT_SIZE
+        self.frames += 1
+        command, data = report[0], bytearray(report[1:])
+
+        if command == qmk.via.ID_DYNAMIC_KEYMAP_SET_BUFFER:
+            offset = (data[0] << 8) | data[1]
+            self.keymap[offset:offset + data[2]] = data[3:3 + data[2]]
+            self.keymap = self.keymap[:KEYMAP_SIZE]
+
+        elif self.bulk and command == qmk.via.ID_DYNAMIC_KEYMAP_BULK_START:
+            offset = (data[0] << 8) | data[1]
+            size = (data[2] << 8) | data[3]
+            self.transfer = None
+            data[0] = qmk.via.BULK_BAD_RANGE
+            if 0 < size <= KEYMAP_SIZE - offset:
+                self.transfer = {'offset': offset, 'remaining': size, 'sequence': 0, 'crc': 0xFF, 'status': qmk.via.BULK_OK}
+                data[0] = qmk.via.BULK_OK
+            data[1] = qmk.via.VIA_REPORT_SIZE - 2
+
+        elif self.bulk and command == qmk.via.ID_DYNAMIC_KEYMAP_BULK_DATA:
+            self.data_reports += 1
+            if self.data_reports in self.drop:
+                self.drop.remove(self.data_reports)
+                return
+
+            transfer = self.transfer
+            if not transfer or transfer['status'] != qmk.via.BULK_OK:
+                return
+
+            if data[0] != transfer['sequence']:
+                transfer['status'] = qmk.via.BULK_LOST_PACKET
+                return
+
+            payload = data[1:1 + min(len(data) - 1, transfer['remaining'])]
+            self.keymap[transfer['offset']:transfer['offset'] + len(payload)] = payload
+            transfer['sequence'] = (transfer['sequence'] + 1) & 0xFF
+            transfer['offset'] += len(payload)
+            transfer['remaining'] -= len(payload)
+            transfer['crc'] = qmk.via.crc8(payload, transfer['crc'])
+            # No reply
+            return
+
+        elif self.bulk and command == qmk.via.ID_DYNAMIC_KEYMAP_BULK_END:
+            transfer = self.transfer or {'status': qmk.via.BULK_LOST_PACKET, 'remaining': 0, 'crc': 0xFF}
+            status = transfer['status']
+            if transfer['remaining'] > 0:
+                status = qmk.via.BULK_LOST_PACKET
+            elif status == qmk.via.BULK_OK and transfer['crc'] != data[0]:
+                status = qmk.via.BULK_CRC_MISMATCH
+            self.transfer = None
+            data[0] = status
+            data[1] = transfer['crc']
+
+        else:
+            command = qmk.via.ID_UNHANDLED
+
+        if self.streaming:
+            self.replies.append(qmk.via._report(qmk.via.ID_SWITCH_MATRIX_DELTA, len(self.replies), 0, 0, 0, 0, 1, 0, 0x01))
+        self.replies.append(bytes([command]) + bytes(data))
+
+    def read(self):
+        self.frames += 1
+        self.round_trips += 1
+
+        return self.replies.pop(0)
+
+
+def keymap_data(seed=1):
+    return bytes((seed + i * 7) & 0xFF for i in range(KEYMAP_SIZE))
+
+
+def test_crc8_check_value():
+    assert qmk.via.crc8(b'123456789') == 0xF7
+    assert qmk.via.crc8(b'56789', qmk.via.crc8(b'1234')) == 0xF7
+
+
+def test_write_keymap_buffer_legacy():
+    keyboard = FakeViaKeyboard(bulk=False)
+    data = keymap_data()
+
+    qmk.via.write_keymap_buffer(keyboard, 0, data)
+
+    assert keyboard.keymap == data
+    assert keyboard.round_trips == 1 + (KEYMAP_SIZE + qmk.via.SET_BUFFER_SIZE - 1) // qmk.via.SET_BUFFER_SIZE
+
+
+def test_write_keymap_buffer_bulk():
+    keyboard = FakeViaKeyboard()
+    data = keymap_data()
+
+    qmk.via.write_keymap_buffer(keyboard, 0, data)
+
+    assert keyboard.keymap == data
+    assert keyboard.round_trips == 2
+
+
+def test_write_keymap_buffer_bulk_speedup():
+    legacy = FakeViaKeyboard()
+    bulk = FakeViaKeyboard()
+    data = keymap_data()
+
+    qmk.via.write_keymap_buffer_legacy(legacy, 0, data)
+    qmk.via.write_keymap_buffer_bulk(bulk, 0, data)
+    speedup = legacy.frames / bulk.frames
+    print(f'{KEYMAP_SIZE} bytes: {legacy.round_trips} round trips in {legacy.frames}ms, bulk {bulk.round_trips} round trips in {bulk.frames}ms, {speedup:.2f}x faster')
+
+    assert legacy.keymap == bulk.keymap == data
+    assert speedup > 1.8
+
+
+def test_write_keymap_buffer_bulk_retries_lost_packet():
+    keyboard = FakeViaKeyboard(drop=[3])
+    data = keymap_data()
+
+    qmk.via.write_keymap_buffer(keyboard, 0, data)
+
+    assert keyboard.keymap == data
+    assert keyboard.round_trips == 4
+
+
+def test_write_keymap_buffer_skips_matrix_delta():
+    keyboard = FakeViaKeyboard(drop=[3], streaming=True)
+    data = keymap_data()
+
+    qmk.via.write_keymap_buffer(keyboard, 0, data)
+
+    assert keyboard.keymap == data
+    assert keyboard.replies == []
+
+
+def test_write_keymap_buffer_bulk_gives_up():
+    keyboard = FakeViaKeyboard(drop=[1, 101, 201])
+
+    try:
+        qmk.via.write_keymap_buffer(keyboard, 0, keymap_data())
+        assert False, 'ViaError not raised'
+    except qmk.via.ViaError as e:
+        assert 'packet lost' in str(e)
+
+
+def test_write_keymap_buffer_bulk_bad_range():
+    keyboard = FakeViaKeyboard()
+
+    try:
+        qmk.via.write_keymap_buffer(keyboard, 100, keymap_data())
+        assert False, 'ViaError not raised'
+    except qmk.via.ViaError as e:
+        assert 'does not fit' in str(e)
+
+
+def test_parse_switch_matrix_delta():
+    report = qmk.via._report(qmk.via.ID_SWITCH_MATRIX_DELTA, 7, 0, 1, 0x86, 0xA0, 0x82, 3, 0x00, 0x00, 0x11, 11, 0x40, 0x00, 0x00)
+
+    delta = qmk.via.parse_switch_matrix_delta(report, 3)
+
+    assert delta == {'sequence': 7, 'time': 100000, 'more': True, 'rows': {3: 0x11, 11: 0x400000}}
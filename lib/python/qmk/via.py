@@ -0,0 +1,126 @@
+"""Functions for talking to keyboards over the VIA raw HID protocol.
+
+`device` is anything with a `write(report)` method sending a 32 byte raw HID report to the keyboard, and a `read()` method returning the next report received from it.
+
+While id_switch_matrix_stream is set, the keyboard also sends id_switch_matrix_delta reports on its own, in between replies. Reports are told apart by their first byte, the command id.
+"""
+VIA_REPORT_SIZE = 32
+
+ID_DYNAMIC_KEYMAP_SET_BUFFER = 0x13
+ID_DYNAMIC_KEYMAP_BULK_START = 0x16
+ID_DYNAMIC_KEYMAP_BULK_DATA = 0x17
+ID_DYNAMIC_KEYMAP_BULK_END = 0x18
+ID_SWITCH_MATRIX_DELTA = 0x19
+ID_UNHANDLED = 0xFF
+
+# Bytes of keymap data in each id_dynamic_keymap_set_buffer report
+SET_BUFFER_SIZE = 28
+
+BULK_OK = 0x00
+BULK_BAD_RANGE = 0x01
+BULK_LOST_PACKET = 0x02
+BULK_CRC_MISMATCH = 0x03
+
+BULK_STATUS = {
+    BULK_OK: 'ok',
+    BULK_BAD_RANGE: 'transfer does not fit the dynamic keymap',
+    BULK_LOST_PACKET: 'packet lost',
+    BULK_CRC_MISMATCH: 'CRC mismatch',
+}
+
+
+class ViaError(Exception):
+    """Raised when the keyboard does not accept a transfer.
+    """
+
+
+def crc8(data, crc=0xFF):
+    """Returns the CRC8 (polynomial 0x31) of data, as calculated by quantum/crc.c.
+
+    Pass the CRC of the previous data as `crc` to continue it.
+    """
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x31) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+
+    return crc
+
+
+def _report(*data):
+    """Returns a raw HID report holding data, padded with zeros.
+    """
+    report = bytes(data)
+
+    return report + bytes(VIA_REPORT_SIZE - len(report))
+
+
+def _command(device, report):
+    """Sends a report and waits for the keyboard's reply, skipping streamed id_switch_matrix_delta reports.
+    """
+    device.write(report)
+
+    while True:
+        reply = device.read()
+        if reply[0] != ID_SWITCH_MATRIX_DELTA:
+            return reply
+
+
+def write_keymap_buffer_legacy(device, offset, data):
+    """Writes data to the dynamic keymap, one id_dynamic_keymap_set_buffer round trip at a time.
+    """
+    for start in range(0, len(data), SET_BUFFER_SIZE):
+        chunk = data[start:start + SET_BUFFER_SIZE]
+        chunk_offset = offset + start
+        _command(device, _report(ID_DYNAMIC_KEYMAP_SET_BUFFER, chunk_offset >> 8, chunk_offset & 0xFF, len(chunk), *chunk))
+
+
+def write_keymap_buffer_bulk(device, offset, data, retries=2):
+    """Streams data to the dynamic keymap, with replies only to the first and last report.
+
+    Returns False when the keyboard does not support bulk transfers. Failed transfers are repeated up to `retries` times, before raising ViaError.
+    """
+    for _ in range(retries + 1):
+        reply = _command(device, _report(ID_DYNAMIC_KEYMAP_BULK_START, offset >> 8, offset & 0xFF, len(data) >> 8, len(data) & 0xFF))
+        if reply[0] == ID_UNHANDLED:
+            return False
+
+        if reply[1] != BULK_OK:
+            raise ViaError(f'Bulk transfer of {len(data)} bytes at {offset} failed: {BULK_STATUS.get(reply[1], reply[1])}')
+
+        payload_size = reply[2]
+        for sequence, start in enumerate(range(0, len(data), payload_size)):
+            device.write(_report(ID_DYNAMIC_KEYMAP_BULK_DATA, sequence & 0xFF, *data[start:start + payload_size]))
+
+        reply = _command(device, _report(ID_DYNAMIC_KEYMAP_BULK_END, crc8(data)))
+        status = reply[1]
+        if status == BULK_OK:
+            return True
+
+    raise ViaError(f'Bulk transfer of {len(data)} bytes at {offset} failed: {BULK_STATUS.get(status, status)}')
+
+
+def write_keymap_buffer(device, offset, data):
+    """Writes data to the dynamic keymap, in bulk if the keyboard supports it.
+    """
+    if not write_keymap_buffer_bulk(device, offset, data):
+        write_keymap_buffer_legacy(device, offset, data)
+
+
+def parse_switch_matrix_delta(report, row_bytes):
+    """Returns the rows changed in an id_switch_matrix_delta report, streamed after setting id_switch_matrix_stream.
+
+    `row_bytes` is the size of a row, as returned when setting id_switch_matrix_stream.
+    """
+    count = report[6] & 0x7F
+    rows = {}
+    for i in range(count):
+        start = 7 + i * (1 + row_bytes)
+        rows[report[start]] = int.from_bytes(report[start + 1:start + 1 + row_bytes], 'big')
+
+    return {
+        'sequence': report[1],
+        'time': int.from_bytes(report[2:6], 'big'),
+        'more': bool(report[6] & 0x80),
+        'rows': rows,
+    }
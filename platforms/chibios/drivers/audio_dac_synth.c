@@ -0,0 +1,182 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "audio.h"
+#include "audio_synth.h"
+#include <ch.h>
+#include <hal.h>
+
+/*
+  Audio Driver: DAC synth
+
+  renders all active tones into one half of a DMA double buffer at a time,
+  through the block based wavetable synthesizer in quantum/audio/audio_synth.c,
+  while the DAC plays back the other half.
+
+  the synthesizer only does integer math per sample, and note changes take
+  effect on an exact sample of the output instead of whenever the callback
+  happens to get around to them.
+*/
+
+#if !defined(AUDIO_PIN)
+#    error "Audio feature enabled, but no suitable pin selected as AUDIO_PIN - see docs/feature_audio under 'ARM (DAC synth)' for available options."
+#endif
+#if defined(AUDIO_PIN_ALT) && !defined(AUDIO_PIN_ALT_AS_NEGATIVE)
+#    pragma message "Audio feature: AUDIO_PIN_ALT set, but not AUDIO_PIN_ALT_AS_NEGATIVE - pin will be left unused; audio might still work though."
+#endif
+
+#if !defined(AUDIO_PIN_ALT)
+// no ALT pin defined is valid, but the c-ifs below need some value set
+#    define AUDIO_PIN_ALT PAL_NOLINE
+#endif
+
+/* the timer triggering the DAC runs at 3 * AUDIO_DAC_SAMPLE_RATE (see the note
+ * on dac_conv_cfg), which results in samples being consumed at 1.5 times the
+ * nominal rate - the same correction audio_dac_additive applies, as measured
+ * with an oscilloscope
+ */
+#define AUDIO_DAC_SYNTH_SAMPLE_RATE (AUDIO_DAC_SAMPLE_RATE * 3 / 2)
+#define AUDIO_DAC_SYNTH_AMPLITUDE MIN(AUDIO_DAC_OFF_VALUE, AUDIO_DAC_SAMPLE_MAX - AUDIO_DAC_OFF_VALUE)
+
+static dacsample_t dac_buffer[AUDIO_DAC_BUFFER_SIZE] = {[0 ... AUDIO_DAC_BUFFER_SIZE - 1] = AUDIO_DAC_OFF_VALUE};
+
+// frequency each synthesizer voice was last set to, to only schedule changes
+static float voice_frequency[AUDIO_SYNTH_VOICES];
+
+typedef enum {
+    OUTPUT_RUNNING,
+    OUTPUT_SHOULD_STOP,
+    OUTPUT_OFF_1,
+    OUTPUT_OFF_2, // both halves of the buffer hold silence, the timer can be stopped
+} output_states_t;
+static output_states_t state = OUTPUT_OFF_2;
+
+#if defined(PORT_SUPPORTS_RT) && (PORT_SUPPORTS_RT == TRUE)
+uint32_t audio_synth_cycle_counter(void) {
+    return chSysGetRealtimeCounterX();
+}
+#endif
+
+/**
+ * Hands the tones currently active in audio.c to the synthesizer, starting
+ * with the next sample it renders.
+ *
+ * I-class: called with the system locked, from the DAC interrupt or a thread.
+ */
+static void dac_synth_update_voices_i(void) {
+    uint32_t now          = audio_synth_now();
+    uint8_t  active_tones = MIN(AUDIO_SYNTH_VOICES, audio_get_number_of_active_tones());
+
+    for (uint8_t i = 0; i < AUDIO_SYNTH_VOICES; i++) {
+        float frequency = i < active_tones ? audio_get_processed_frequency(i) : 0.0f;
+        if (frequency != voice_frequency[i]) {
+            voice_frequency[i] = frequency;
+            audio_synth_note_on_i(i, frequency, now);
+        }
+    }
+}
+
+/**
+ * DAC streaming callback, called for the 'half buffer event' and the 'full
+ * buffer event'; each time rendering the half the DAC just finished with.
+ */
+static void dac_end(DACDriver *dacp) {
+    dacsample_t *sample_p = (dacp)->samples;
+
+    // work on the other half of the buffer
+    if (dacIsBufferComplete(dacp)) {
+        sample_p += AUDIO_DAC_BUFFER_SIZE / 2; // 'half_index'
+    }
+
+    audio_synth_render(sample_p, AUDIO_DAC_BUFFER_SIZE / 2);
+
+    if (OUTPUT_RUNNING == state) {
+        // update audio internal state (note position, current_note, ...)
+        if (audio_update_state()) {
+            chSysLockFromISR();
+            dac_synth_update_voices_i();
+            chSysUnlockFromISR();
+        }
+    } else if (OUTPUT_OFF_2 == state) {
+        gptStopTimer(&GPTD6);
+    } else if (OUTPUT_SHOULD_STOP != state || audio_synth_is_silent()) {
+        state++;
+    }
+}
+
+static void dac_error(DACDriver *dacp, dacerror_t err) {
+    (void)dacp;
+    (void)err;
+
+    chSysHalt("DAC failure. halp");
+}
+
+static const GPTConfig gpt6cfg1 = {.frequency = AUDIO_DAC_SAMPLE_RATE * 3,
+                                   .callback  = NULL,
+                                   .cr2       = TIM_CR2_MMS_1, /* MMS = 010 = TRGO on Update Event.  */
+                                   .dier      = 0U};
+
+static const DACConfig dac_conf = {.init = AUDIO_DAC_OFF_VALUE, .datamode = DAC_DHRM_12BIT_RIGHT};
+
+/**
+ * @note The DAC_TRG(0) here selects the Timer 6 TRGO event, which is triggered
+ * on the rising edge after 3 APB1 clock cycles, causing our gpt6cfg1.frequency
+ * to be a third of what we expect.
+ */
+static const DACConversionGroup dac_conv_cfg = {.num_channels = 1U, .end_cb = dac_end, .error_cb = dac_error, .trigger = DAC_TRG(0b000)};
+
+void audio_driver_initialize() {
+    if ((AUDIO_PIN == A4) || (AUDIO_PIN_ALT == A4)) {
+        palSetLineMode(A4, PAL_MODE_INPUT_ANALOG);
+        dacStart(&DACD1, &dac_conf);
+    }
+    if ((AUDIO_PIN == A5) || (AUDIO_PIN_ALT == A5)) {
+        palSetLineMode(A5, PAL_MODE_INPUT_ANALOG);
+        dacStart(&DACD2, &dac_conf);
+    }
+
+    // enable the output buffer, see audio_dac_additive.c for the details
+    DACD1.params->dac->CR &= ~DAC_CR_BOFF1;
+    DACD2.params->dac->CR &= ~DAC_CR_BOFF2;
+
+    audio_synth_init(AUDIO_DAC_SYNTH_SAMPLE_RATE, AUDIO_DAC_OFF_VALUE, AUDIO_DAC_SYNTH_AMPLITUDE);
+
+    if (AUDIO_PIN == A4) {
+        dacStartConversion(&DACD1, &dac_conv_cfg, dac_buffer, AUDIO_DAC_BUFFER_SIZE);
+    } else if (AUDIO_PIN == A5) {
+        dacStartConversion(&DACD2, &dac_conv_cfg, dac_buffer, AUDIO_DAC_BUFFER_SIZE);
+    }
+
+    // no inverted/out-of-phase waveform (yet?), only pulling AUDIO_PIN_ALT to AUDIO_DAC_OFF_VALUE
+#if defined(AUDIO_PIN_ALT_AS_NEGATIVE)
+    if (AUDIO_PIN_ALT == A4) {
+        dacPutChannelX(&DACD1, 0, AUDIO_DAC_OFF_VALUE);
+    } else if (AUDIO_PIN_ALT == A5) {
+        dacPutChannelX(&DACD2, 0, AUDIO_DAC_OFF_VALUE);
+    }
+#endif
+
+    gptStart(&GPTD6, &gpt6cfg1);
+}
+
+// also reached from dac_end, through audio_update_state, so lock for any context
+void audio_driver_stop(void) {
+    syssts_t sts = chSysGetStatusAndLockX();
+    audio_synth_all_off_i();
+    for (uint8_t i = 0; i < AUDIO_SYNTH_VOICES; i++) {
+        voice_frequency[i] = 0.0f;
+    }
+    state = OUTPUT_SHOULD_STOP;
+    chSysRestoreStatusX(sts);
+}
+
+void audio_driver_start(void) {
+    syssts_t sts = chSysGetStatusAndLockX();
+    dac_synth_update_voices_i();
+    state = OUTPUT_RUNNING;
+    chSysRestoreStatusX(sts);
+    // the timer keeps running while a stop is still fading out
+    if (GPTD6.state == GPT_READY) {
+        gptStartContinuous(&GPTD6, 2U);
+    }
+}
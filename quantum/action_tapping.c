@@ -1,5 +1,6 @@
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #ifdef DEBUG_ACTION
 #    include "debug.h"
@@ -11,6 +12,7 @@
 #include "action_layer.h"
 #include "action_tapping.h"
 #include "keycode.h"
+#include "matrix.h"
 #include "timer.h"
 
 #ifndef NO_ACTION_TAPPING
@@ -62,17 +64,33 @@ __attribute__((weak)) bool get_hold_on_other_key_press(uint16_t keycode, keyreco
 #        include "process_auto_shift.h"
 #    endif
 
+#    if WAITING_BUFFER_SIZE < 2 || WAITING_BUFFER_SIZE > 256
+#        error WAITING_BUFFER_SIZE must be between 2 and 256
+#    endif
+
 static keyrecord_t tapping_key                         = {};
 static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE] = {};
 static uint8_t     waiting_buffer_head                 = 0;
 static uint8_t     waiting_buffer_tail                 = 0;
 
+// number of queued press and release events, kept in step with head and tail
+static uint8_t                waiting_buffer_pressed  = 0;
+static uint8_t                waiting_buffer_released = 0;
+static waiting_buffer_stats_t waiting_buffer_stats    = {};
+
+// matrix keys with a queued press, so waiting_buffer_typed() needs no scan;
+// dups counts the queued presses beyond the first of the same key
+static matrix_row_t waiting_buffer_pressed_keys[MATRIX_ROWS] = {};
+static uint8_t      waiting_buffer_pressed_dups              = 0;
+
 static bool process_tapping(keyrecord_t *record);
 static bool waiting_buffer_enq(keyrecord_t record);
+static void waiting_buffer_deq(void);
 static void waiting_buffer_clear(void);
 static bool waiting_buffer_typed(keyevent_t event);
 static bool waiting_buffer_has_anykey_pressed(void);
 static void waiting_buffer_scan_tap(void);
+static bool waiting_buffer_find_press(keypos_t key);
 static void debug_tapping_key(void);
 static void debug_waiting_buffer(void);
 
@@ -91,6 +109,9 @@ void action_tapping_process(keyrecord_t record) {
         if (!waiting_buffer_enq(record)) {
             // clear all in case of overflow.
             debug("OVERFLOW: CLEAR ALL STATES\n");
+            if (waiting_buffer_stats.overflows < UINT16_MAX) {
+                waiting_buffer_stats.overflows++;
+            }
             clear_keyboard();
             waiting_buffer_clear();
             tapping_key = (keyrecord_t){};
@@ -101,13 +122,14 @@ void action_tapping_process(keyrecord_t record) {
     if (!IS_NOEVENT(record.event) && waiting_buffer_head != waiting_buffer_tail) {
         debug("---- action_exec: process waiting_buffer -----\n");
     }
-    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
+    while (waiting_buffer_tail != waiting_buffer_head) {
         if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
             debug("processed: waiting_buffer[");
             debug_dec(waiting_buffer_tail);
             debug("] = ");
             debug_record(waiting_buffer[waiting_buffer_tail]);
             debug("\n\n");
+            waiting_buffer_deq();
         } else {
             break;
         }
@@ -231,7 +253,12 @@ bool process_tapping(keyrecord_t *keyp) {
                  */
                 else if (IS_RELEASED(event) && !waiting_buffer_typed(event)) {
                     // Modifier should be retained till end of this tapping.
+#    ifdef COMBO_ENABLE
+                    // combo events have no position to look the action up by
+                    action_t action = keyp->keycode ? action_for_keycode(keyp->keycode) : layer_switch_get_action(event.key);
+#    else
                     action_t action = layer_switch_get_action(event.key);
+#    endif
                     switch (action.kind.id) {
                         case ACT_LMODS:
                         case ACT_RMODS:
@@ -455,6 +482,23 @@ bool waiting_buffer_enq(keyrecord_t record) {
 
     waiting_buffer[waiting_buffer_head] = record;
     waiting_buffer_head                 = (waiting_buffer_head + 1) % WAITING_BUFFER_SIZE;
+    if (record.event.pressed) {
+        waiting_buffer_pressed++;
+        if (record.event.key.row < MATRIX_ROWS && record.event.key.col < MATRIX_COLS) {
+            matrix_row_t bit = (matrix_row_t)1 << record.event.key.col;
+            if (waiting_buffer_pressed_keys[record.event.key.row] & bit) {
+                waiting_buffer_pressed_dups++;
+            }
+            waiting_buffer_pressed_keys[record.event.key.row] |= bit;
+        }
+    } else {
+        waiting_buffer_released++;
+    }
+
+    uint8_t used = waiting_buffer_pressed + waiting_buffer_released;
+    if (used > waiting_buffer_stats.high_water) {
+        waiting_buffer_stats.high_water = used;
+    }
 
     debug("waiting_buffer_enq: ");
     debug_waiting_buffer();
@@ -466,15 +510,62 @@ bool waiting_buffer_enq(keyrecord_t record) {
  * FIXME: Needs docs
  */
 void waiting_buffer_clear(void) {
-    waiting_buffer_head = 0;
-    waiting_buffer_tail = 0;
+    waiting_buffer_head     = 0;
+    waiting_buffer_tail     = 0;
+    waiting_buffer_pressed  = 0;
+    waiting_buffer_released = 0;
+    memset(waiting_buffer_pressed_keys, 0, sizeof(waiting_buffer_pressed_keys));
+    waiting_buffer_pressed_dups = 0;
+}
+
+/** \brief Waiting buffer deq
+ *
+ * Drops the oldest event once it has been processed.
+ */
+void waiting_buffer_deq(void) {
+    keyevent_t event    = waiting_buffer[waiting_buffer_tail].event;
+    waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE;
+    if (!event.pressed) {
+        waiting_buffer_released--;
+        return;
+    }
+
+    waiting_buffer_pressed--;
+    if (event.key.row < MATRIX_ROWS && event.key.col < MATRIX_COLS) {
+        // only rescan when some key has more than one press queued
+        if (waiting_buffer_pressed_dups > 0 && waiting_buffer_find_press(event.key)) {
+            waiting_buffer_pressed_dups--;
+        } else {
+            waiting_buffer_pressed_keys[event.key.row] &= ~((matrix_row_t)1 << event.key.col);
+        }
+    }
+}
+
+/** \brief Waiting buffer statistics
+ *
+ * Number of overflows and the deepest the buffer has been since the last clear.
+ */
+void waiting_buffer_get_stats(waiting_buffer_stats_t *stats) {
+    *stats = waiting_buffer_stats;
+}
+
+void waiting_buffer_clear_stats(void) {
+    waiting_buffer_stats = (waiting_buffer_stats_t){};
 }
 
 /** \brief Waiting buffer typed
  *
- * FIXME: Needs docs
+ * Whether the waiting buffer holds the other half of this key's press and release.
+ * Releases of matrix keys are answered from the index of queued presses.
  */
 bool waiting_buffer_typed(keyevent_t event) {
+    // nothing queued can pair up with this event
+    if ((event.pressed ? waiting_buffer_released : waiting_buffer_pressed) == 0) {
+        return false;
+    }
+    if (!event.pressed && event.key.row < MATRIX_ROWS && event.key.col < MATRIX_COLS) {
+        return waiting_buffer_pressed_keys[event.key.row] & ((matrix_row_t)1 << event.key.col);
+    }
     for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
         if (KEYEQ(event.key, waiting_buffer[i].event.key) && event.pressed != waiting_buffer[i].event.pressed) {
             return true;
@@ -483,17 +574,27 @@ bool waiting_buffer_typed(keyevent_t event) {
     return false;
 }
 
-/** \brief Waiting buffer has anykey pressed
+/** \brief Waiting buffer find press
  *
- * FIXME: Needs docs
+ * Whether a press of this key is still queued.
  */
-__attribute__((unused)) bool waiting_buffer_has_anykey_pressed(void) {
+static bool waiting_buffer_find_press(keypos_t key) {
     for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (waiting_buffer[i].event.pressed) return true;
+        if (KEYEQ(key, waiting_buffer[i].event.key) && waiting_buffer[i].event.pressed) {
+            return true;
+        }
     }
     return false;
 }
 
+/** \brief Waiting buffer has anykey pressed
+ *
+ * FIXME: Needs docs
+ */
+__attribute__((unused)) bool waiting_buffer_has_anykey_pressed(void) {
+    return waiting_buffer_pressed > 0;
+}
+
 /** \brief Scan buffer for tapping
  *
  * FIXME: Needs docs
@@ -503,6 +604,8 @@ void waiting_buffer_scan_tap(void) {
     if (tapping_key.tap.count > 0) return;
     // invalid state: tapping_key released && tap.count == 0
     if (!tapping_key.event.pressed) return;
+    // only a queued release can complete the tap
+    if (waiting_buffer_released == 0) return;
 
     for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
         if (IS_TAPPING_KEY(waiting_buffer[i].event.key) && !waiting_buffer[i].event.pressed && WITHIN_TAPPING_TERM(waiting_buffer[i].event)) {
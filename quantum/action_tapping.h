@@ -27,12 +27,24 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define TAPPING_TOGGLE 5
 #endif
 
-#define WAITING_BUFFER_SIZE 8
+/* number of key events held back while a tap-hold decision is pending */
+#ifndef WAITING_BUFFER_SIZE
+#    define WAITING_BUFFER_SIZE 16
+#endif
 
 #ifndef NO_ACTION_TAPPING
 uint16_t get_record_keycode(keyrecord_t *record, bool update_layer_cache);
 uint16_t get_event_keycode(keyevent_t event, bool update_layer_cache);
 void     action_tapping_process(keyrecord_t record);
+
+/* waiting buffer statistics */
+typedef struct {
+    uint16_t overflows;
+    uint8_t  high_water;
+} waiting_buffer_stats_t;
+
+void waiting_buffer_get_stats(waiting_buffer_stats_t *stats);
+void waiting_buffer_clear_stats(void);
 #endif
 
 uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record);
@@ -36,6 +36,14 @@ static uint8_t suppressed_mods    = 0;
 // report_keyboard_t keyboard_report = {};
 report_keyboard_t *keyboard_report = &(report_keyboard_t){};
 
+#ifdef BATCH_KEYBOARD_REPORTS
+static report_keyboard_t pending_report;
+static bool              report_batching      = false;
+static bool              report_pending       = false;
+static uint8_t           report_batch_event   = 0;
+static uint8_t           report_pending_event = 0;
+#endif
+
 extern inline void add_key(uint8_t key);
 extern inline void del_key(uint8_t key);
 extern inline void clear_keys(void);
@@ -240,6 +248,19 @@ bool is_oneshot_enabled(void) {
 
 #endif
 
+static report_keyboard_t last_report;
+
+static void send_report_to_host(report_keyboard_t *report) {
+#ifndef PROTOCOL_VUSB
+    /* Only send the report if there are changes to propagate to the host. */
+    if (memcmp(report, &last_report, sizeof(report_keyboard_t)) == 0) {
+        return;
+    }
+#endif
+    memcpy(&last_report, report, sizeof(report_keyboard_t));
+    host_keyboard_send(report);
+}
+
 /** \brief Send keyboard report
  *
  * FIXME: needs doc
@@ -270,15 +291,60 @@ void send_keyboard_report(void) {
     keyboard_report->mods |= weak_override_mods;
 #endif
 
-#ifdef PROTOCOL_VUSB
-    host_keyboard_send(keyboard_report);
-#else
-    static report_keyboard_t last_report;
+#ifdef BATCH_KEYBOARD_REPORTS
+    if (report_batching) {
+        /* Changes made by separate events of the same batch are reported together.
+         * Reports of a single event, keys released by one event and pressed
+         * again by the next, and mod changes are sent in order so that no tap
+         * is lost and no key is reported with the wrong mods. */
+        if (report_pending && (report_pending_event == report_batch_event || pending_report.mods != keyboard_report->mods || is_key_repressed(&last_report, &pending_report, keyboard_report))) {
+            send_report_to_host(&pending_report);
+        }
+        memcpy(&pending_report, keyboard_report, sizeof(report_keyboard_t));
+        report_pending       = true;
+        report_pending_event = report_batch_event;
+        return;
+    }
+#endif
 
-    /* Only send the report if there are changes to propagate to the host. */
-    if (memcmp(keyboard_report, &last_report, sizeof(report_keyboard_t)) != 0) {
-        memcpy(&last_report, keyboard_report, sizeof(report_keyboard_t));
-        host_keyboard_send(keyboard_report);
+    send_report_to_host(keyboard_report);
+}
+
+/** \brief Begin keyboard report batch
+ *
+ * Starts a new event of the current batch, or a new batch if none is running.
+ * The last report of each event is held back until the next one, and merged into
+ * it unless that would hide a tap. With BATCH_KEYBOARD_REPORTS defined this
+ * is used by matrix_task so that keys changing in the same scan are reported together.
+ */
+void begin_keyboard_report_batch(void) {
+#ifdef BATCH_KEYBOARD_REPORTS
+    report_batching = true;
+    report_batch_event++;
+#endif
+}
+
+/** \brief End keyboard report batch
+ *
+ * Ends the current batch and sends the report held back by it, if any.
+ */
+void end_keyboard_report_batch(void) {
+#ifdef BATCH_KEYBOARD_REPORTS
+    flush_keyboard_report();
+    report_batching = false;
+#endif
+}
+
+/** \brief Flush keyboard report
+ *
+ * Sends the report held back by the current batch, if any. Must be called before
+ * waiting in between reports, so that the delay reaches the host.
+ */
+void flush_keyboard_report(void) {
+#ifdef BATCH_KEYBOARD_REPORTS
+    if (report_pending) {
+        report_pending = false;
+        send_report_to_host(&pending_report);
     }
 #endif
 }
@@ -27,6 +27,9 @@ extern "C" {
 extern report_keyboard_t *keyboard_report;
 
 void send_keyboard_report(void);
+void begin_keyboard_report_batch(void);
+void end_keyboard_report_batch(void);
+void flush_keyboard_report(void);
 
 /* key */
 inline void add_key(uint8_t key) {
@@ -0,0 +1,275 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "audio_synth.h"
+#include "luts.h"
+#include "atomic_util.h"
+#include <string.h>
+
+// the top bits of a voice's 32bit phase select the wavetable entry
+#define SYNTH_PHASE_SHIFT (32 - 8)
+#define SYNTH_GAIN_MAX 256
+#define SYNTH_GAIN_STEP ((SYNTH_GAIN_MAX + AUDIO_SYNTH_RAMP_SAMPLES - 1) / AUDIO_SYNTH_RAMP_SAMPLES)
+
+_Static_assert(SINE_LUT_LENGTH == 1 << (32 - SYNTH_PHASE_SHIFT), "SYNTH_PHASE_SHIFT does not match the wavetable length");
+
+typedef struct {
+    uint32_t phase;
+    uint32_t increment; // phase advance per sample
+    uint16_t gain;
+    uint16_t target;
+} synth_voice_t;
+
+typedef struct {
+    uint32_t at;
+    uint32_t increment; // 0 stops the voice
+    uint8_t  voice;
+} synth_event_t;
+
+static synth_voice_t       voices[AUDIO_SYNTH_VOICES];
+static synth_event_t       events[AUDIO_SYNTH_EVENT_QUEUE_SIZE];
+static uint8_t             event_count       = 0;
+static uint32_t            sample_clock      = 0;
+static uint32_t            synth_sample_rate = 1;
+static uint16_t            synth_off_value   = 0;
+static int32_t             synth_amplitude   = 0;
+static audio_synth_stats_t stats;
+
+__attribute__((weak)) uint32_t audio_synth_cycle_counter(void) {
+    return 0;
+}
+
+/**
+ * \brief Silences all voices and restarts the sample clock
+ *
+ * \param sample_rate rate at which the output consumes samples, in Hz
+ * \param off_value   sample value at rest, the center of the waveform
+ * \param amplitude   largest deviation from off_value when all voices are at full volume
+ */
+void audio_synth_init(uint32_t sample_rate, uint16_t off_value, uint16_t amplitude) {
+    ATOMIC_BLOCK_FORCEON {
+        memset(voices, 0, sizeof(voices));
+        event_count       = 0;
+        sample_clock      = 0;
+        synth_sample_rate = sample_rate ? sample_rate : 1;
+        synth_off_value   = off_value;
+        synth_amplitude   = amplitude;
+    }
+    audio_synth_reset_stats();
+}
+
+/**
+ * \brief The sample clock: number of samples rendered since audio_synth_init
+ *
+ * Events scheduled for this sample take effect at the start of the next
+ * rendered block.
+ */
+uint32_t audio_synth_now(void) {
+    return sample_clock;
+}
+
+uint32_t audio_synth_ms_to_samples(uint32_t ms) {
+    return (ms / 1000) * synth_sample_rate + (ms % 1000) * synth_sample_rate / 1000;
+}
+
+/**
+ * \brief Inserts an event into the queue, keeping it sorted by time
+ *
+ * Events for the same sample are applied in the order they were scheduled.
+ * The caller has to keep the renderer out, see the _i functions.
+ */
+static bool synth_schedule(uint8_t voice, uint32_t increment, uint32_t at) {
+    if (voice >= AUDIO_SYNTH_VOICES) {
+        return false;
+    }
+
+    if (event_count == AUDIO_SYNTH_EVENT_QUEUE_SIZE) {
+        stats.dropped_events++;
+        return false;
+    }
+
+    if ((int32_t)(at - sample_clock) < 0) {
+        stats.late_events++;
+        at = sample_clock;
+    }
+
+    uint8_t i = event_count;
+    while (i > 0 && (int32_t)(events[i - 1].at - at) > 0) {
+        events[i] = events[i - 1];
+        i--;
+    }
+    events[i] = (synth_event_t){.at = at, .increment = increment, .voice = voice};
+    event_count++;
+    return true;
+}
+
+// phase advance per sample for a frequency, 0 for rests and frequencies the sample rate can't carry
+static uint32_t synth_increment(float frequency) {
+    if (frequency <= 0.0f || frequency * 2 >= synth_sample_rate) {
+        return 0;
+    }
+    return (uint32_t)(frequency * (4294967296.0f / synth_sample_rate));
+}
+
+/**
+ * \brief Starts a voice, or changes its frequency, at the given sample
+ *
+ * The phase is kept when a sounding voice changes frequency, so there is no
+ * discontinuity in the waveform. Frequencies of 0 (rests) stop the voice.
+ */
+bool audio_synth_note_on(uint8_t voice, float frequency, uint32_t at) {
+    bool scheduled = false;
+    ATOMIC_BLOCK_FORCEON {
+        scheduled = audio_synth_note_on_i(voice, frequency, at);
+    }
+    return scheduled;
+}
+
+/**
+ * \brief Fades a voice out, starting at the given sample
+ */
+bool audio_synth_note_off(uint8_t voice, uint32_t at) {
+    bool scheduled = false;
+    ATOMIC_BLOCK_FORCEON {
+        scheduled = audio_synth_note_off_i(voice, at);
+    }
+    return scheduled;
+}
+
+/**
+ * \brief Drops all scheduled events and fades out all voices
+ */
+void audio_synth_all_off(void) {
+    ATOMIC_BLOCK_FORCEON {
+        audio_synth_all_off_i();
+    }
+}
+
+/**
+ * \brief audio_synth_note_on, for callers that already keep the renderer out
+ *
+ * Meant for the output driver's interrupt, and for code that holds the
+ * platform's interrupt lock - e.g. chSysLockFromISR on ChibiOS, where
+ * audio_synth_note_on's ATOMIC_BLOCK is not allowed.
+ */
+bool audio_synth_note_on_i(uint8_t voice, float frequency, uint32_t at) {
+    return synth_schedule(voice, synth_increment(frequency), at);
+}
+
+bool audio_synth_note_off_i(uint8_t voice, uint32_t at) {
+    return synth_schedule(voice, 0, at);
+}
+
+void audio_synth_all_off_i(void) {
+    event_count = 0;
+    for (uint8_t i = 0; i < AUDIO_SYNTH_VOICES; i++) {
+        voices[i].target = 0;
+    }
+}
+
+bool audio_synth_is_silent(void) {
+    if (event_count > 0) {
+        return false;
+    }
+    for (uint8_t i = 0; i < AUDIO_SYNTH_VOICES; i++) {
+        if (voices[i].gain > 0 || voices[i].target > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void synth_apply_event(const synth_event_t *event) {
+    synth_voice_t *voice = &voices[event->voice];
+    if (event->increment == 0) {
+        voice->target = 0;
+    } else {
+        if (voice->gain == 0) {
+            voice->phase = 0;
+        }
+        voice->increment = event->increment;
+        voice->target    = SYNTH_GAIN_MAX;
+    }
+}
+
+static inline uint16_t synth_ramp(uint16_t gain, uint16_t target) {
+    if (gain < target) {
+        return gain + SYNTH_GAIN_STEP < target ? gain + SYNTH_GAIN_STEP : target;
+    }
+    return gain > SYNTH_GAIN_STEP ? gain - SYNTH_GAIN_STEP : 0;
+}
+
+/**
+ * \brief Mixes all sounding voices into a run of samples without events
+ *
+ * The mix is scaled by the number of voices rather than the number of
+ * sounding ones, so starting or stopping a note never changes the volume of
+ * the others.
+ */
+static void synth_render_run(uint16_t *samples, uint16_t count) {
+    for (uint16_t s = 0; s < count; s++) {
+        int32_t mix = 0;
+        for (uint8_t i = 0; i < AUDIO_SYNTH_VOICES; i++) {
+            synth_voice_t *voice = &voices[i];
+            if (voice->gain != voice->target) {
+                voice->gain = synth_ramp(voice->gain, voice->target);
+            }
+            if (voice->gain == 0) {
+                continue;
+            }
+            mix += ((int32_t)sine_lut[voice->phase >> SYNTH_PHASE_SHIFT] * voice->gain) >> 8;
+            voice->phase += voice->increment;
+        }
+        samples[s] = synth_off_value + (((mix / AUDIO_SYNTH_VOICES) * synth_amplitude) >> 15);
+    }
+}
+
+/**
+ * \brief Renders the next block of samples, advancing the sample clock
+ *
+ * Scheduled events are applied on exactly the sample they were scheduled
+ * for, splitting the block into runs between events. Meant to be called
+ * from the DMA half/full transfer interrupt of the output driver.
+ */
+void audio_synth_render(uint16_t *samples, uint16_t count) {
+    uint32_t start = audio_synth_cycle_counter();
+
+    while (count > 0) {
+        while (event_count > 0 && (int32_t)(events[0].at - sample_clock) <= 0) {
+            synth_apply_event(&events[0]);
+            event_count--;
+            memmove(&events[0], &events[1], event_count * sizeof(synth_event_t));
+        }
+
+        uint16_t run = count;
+        if (event_count > 0 && events[0].at - sample_clock < run) {
+            run = events[0].at - sample_clock;
+        }
+
+        synth_render_run(samples, run);
+        samples += run;
+        count -= run;
+        sample_clock += run;
+    }
+
+    stats.blocks++;
+    stats.last_cycles = audio_synth_cycle_counter() - start;
+    if (stats.last_cycles > stats.max_cycles) {
+        stats.max_cycles = stats.last_cycles;
+    }
+}
+
+/**
+ * \brief Reports the rendering cost per block, in audio_synth_cycle_counter units
+ */
+void audio_synth_get_stats(audio_synth_stats_t *out) {
+    ATOMIC_BLOCK_FORCEON {
+        *out = stats;
+    }
+}
+
+void audio_synth_reset_stats(void) {
+    ATOMIC_BLOCK_FORCEON {
+        memset(&stats, 0, sizeof(stats));
+    }
+}
@@ -0,0 +1,68 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* audio_synth: block based wavetable synthesis
+ *
+ * renders a number of voices into a buffer of samples at a time, e.g. one
+ * half of a DMA double buffer, using integer math only. notes are started and
+ * stopped through events carrying the sample they take effect on, so their
+ * timing only depends on the sample clock - how many samples have been
+ * rendered so far - and not on when the rendering or the scheduling happens
+ * to run.
+ */
+
+// number of tones that can sound at the same time
+#ifndef AUDIO_SYNTH_VOICES
+#    define AUDIO_SYNTH_VOICES 4
+#endif
+
+// number of note events that can be scheduled ahead of the sample clock
+#ifndef AUDIO_SYNTH_EVENT_QUEUE_SIZE
+#    define AUDIO_SYNTH_EVENT_QUEUE_SIZE 16
+#endif
+
+// samples over which a voice fades in or out, to avoid clicks
+#ifndef AUDIO_SYNTH_RAMP_SAMPLES
+#    define AUDIO_SYNTH_RAMP_SAMPLES 32
+#endif
+
+#if AUDIO_SYNTH_VOICES < 1 || AUDIO_SYNTH_VOICES > 16
+#    error "AUDIO_SYNTH_VOICES has to be between 1 and 16"
+#endif
+
+typedef struct {
+    uint32_t blocks;           // number of blocks rendered
+    uint32_t last_cycles;      // cost of the most recent block
+    uint32_t max_cycles;       // cost of the most expensive block
+    uint16_t dropped_events;   // events not scheduled because the queue was full
+    uint16_t late_events;      // events scheduled for a sample that had already been rendered
+} audio_synth_stats_t;
+
+void     audio_synth_init(uint32_t sample_rate, uint16_t off_value, uint16_t amplitude);
+void     audio_synth_render(uint16_t *samples, uint16_t count);
+uint32_t audio_synth_now(void);
+uint32_t audio_synth_ms_to_samples(uint32_t ms);
+bool     audio_synth_note_on(uint8_t voice, float frequency, uint32_t at);
+bool     audio_synth_note_off(uint8_t voice, uint32_t at);
+void     audio_synth_all_off(void);
+bool     audio_synth_is_silent(void);
+
+/* same as above, without taking the interrupt lock: for the output driver's
+ * interrupt, or callers already holding the lock.
+ */
+bool audio_synth_note_on_i(uint8_t voice, float frequency, uint32_t at);
+bool audio_synth_note_off_i(uint8_t voice, uint32_t at);
+void audio_synth_all_off_i(void);
+
+void audio_synth_get_stats(audio_synth_stats_t *stats);
+void audio_synth_reset_stats(void);
+
+/* free running counter used to measure the cost of each block, in whatever
+ * unit the platform provides - e.g. cpu cycles. returns 0 unless overridden.
+ */
+uint32_t audio_synth_cycle_counter(void);
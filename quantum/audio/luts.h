@@ -23,5 +23,8 @@
 
 #define FREQUENCY_LUT_LENGTH 349
 
+#define SINE_LUT_LENGTH 256
+
 extern const float    vibrato_lut[VIBRATO_LUT_LENGTH];
 extern const uint16_t frequency_lut[FREQUENCY_LUT_LENGTH];
+extern const int16_t  sine_lut[SINE_LUT_LENGTH];
@@ -0,0 +1,245 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "audio_synth.h"
+#include "wav_dump.h"
+
+uint32_t audio_synth_cycle_counter(void) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
+
+#define SAMPLE_RATE 16384
+#define OFF_VALUE 2048
+#define AMPLITUDE 2047
+
+class AudioSynth : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        audio_synth_init(SAMPLE_RATE, OFF_VALUE, AMPLITUDE);
+    }
+
+    std::vector<uint16_t> render(uint32_t count, uint16_t block_size = 128) {
+        std::vector<uint16_t> samples(count);
+        for (uint32_t i = 0; i < count; i += block_size) {
+            audio_synth_render(&samples[i], std::min<uint32_t>(block_size, count - i));
+        }
+        return samples;
+    }
+
+    // Set AUDIO_SYNTH_WAV_DIR to keep what a test rendered, e.g. to listen to it
+    void dump(const std::vector<uint16_t> &samples) {
+        const char *dir = std::getenv("AUDIO_SYNTH_WAV_DIR");
+        if (dir == nullptr) {
+            return;
+        }
+        std::string path = std::string(dir) + "/" + ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".wav";
+        EXPECT_TRUE(wav_dump(path.c_str(), samples.data(), samples.size(), SAMPLE_RATE, OFF_VALUE));
+    }
+
+    static uint32_t rising_zero_crossings(const std::vector<uint16_t> &samples) {
+        uint32_t crossings = 0;
+        for (size_t i = 1; i < samples.size(); i++) {
+            if (samples[i - 1] < OFF_VALUE && samples[i] >= OFF_VALUE) {
+                crossings++;
+            }
+        }
+        return crossings;
+    }
+};
+
+TEST_F(AudioSynth, SilentWithoutNotes) {
+    for (uint16_t sample : render(1000)) {
+        EXPECT_EQ(sample, OFF_VALUE);
+    }
+    EXPECT_TRUE(audio_synth_is_silent());
+    EXPECT_EQ(audio_synth_now(), 1000);
+}
+
+TEST_F(AudioSynth, FrequencyIsAccurate) {
+    audio_synth_note_on(0, 440.0f, 0);
+    auto samples = render(SAMPLE_RATE);
+    dump(samples);
+
+    EXPECT_NEAR(rising_zero_crossings(samples), 440, 1);
+}
+
+TEST_F(AudioSynth, NoteStartsOnScheduledSample) {
+    audio_synth_note_on(0, 1000.0f, 1000);
+    auto samples = render(2000);
+
+    for (int i = 0; i <= 1000; i++) {
+        EXPECT_EQ(samples[i], OFF_VALUE) << "at sample " << i;
+    }
+    EXPECT_NE(samples[1002], OFF_VALUE);
+}
+
+TEST_F(AudioSynth, OutputDoesNotDependOnBlockSize) {
+    std::vector<uint16_t> reference;
+    for (uint16_t block_size : {1, 37, 128, 4096}) {
+        audio_synth_init(SAMPLE_RATE, OFF_VALUE, AMPLITUDE);
+        audio_synth_note_on(0, 523.25f, 100);
+        audio_synth_note_on(1, 659.25f, 777);
+        audio_synth_note_off(0, 2500);
+        audio_synth_note_on(0, 783.99f, 3000);
+        audio_synth_note_off(1, 3001);
+
+        auto samples = render(4096, block_size);
+        if (reference.empty()) {
+            reference = samples;
+        } else {
+            EXPECT_EQ(samples, reference) << "with blocks of " << block_size << " samples";
+        }
+    }
+}
+
+// what the output driver does from its interrupt, between two blocks
+TEST_F(AudioSynth, InterruptVariantsScheduleTheSame) {
+    std::vector<uint16_t> reference;
+    for (bool from_isr : {false, true}) {
+        audio_synth_init(SAMPLE_RATE, OFF_VALUE, AMPLITUDE);
+        std::vector<uint16_t> samples;
+        for (uint32_t block = 0; block < 32; block++) {
+            if (block == 2) {
+                from_isr ? audio_synth_note_on_i(0, 523.25f, audio_synth_now()) : audio_synth_note_on(0, 523.25f, audio_synth_now());
+                from_isr ? audio_synth_note_on_i(1, 659.25f, audio_synth_now()) : audio_synth_note_on(1, 659.25f, audio_synth_now());
+            } else if (block == 10) {
+                from_isr ? audio_synth_note_off_i(0, audio_synth_now()) : audio_synth_note_off(0, audio_synth_now());
+            } else if (block == 20) {
+                from_isr ? audio_synth_all_off_i() : audio_synth_all_off();
+            }
+            auto rendered = render(128);
+            samples.insert(samples.end(), rendered.begin(), rendered.end());
+        }
+
+        EXPECT_NE(samples[3 * 128], OFF_VALUE);
+        EXPECT_TRUE(audio_synth_is_silent());
+        if (reference.empty()) {
+            reference = samples;
+        } else {
+            EXPECT_EQ(samples, reference);
+        }
+    }
+}
+
+TEST_F(AudioSynth, NoteOffFadesOut) {
+    audio_synth_note_on(0, 440.0f, 0);
+    render(1000);
+
+    audio_synth_note_off(0, audio_synth_now());
+    auto samples = render(AUDIO_SYNTH_RAMP_SAMPLES + 100);
+
+    EXPECT_NE(samples[1], OFF_VALUE);
+    for (size_t i = AUDIO_SYNTH_RAMP_SAMPLES; i < samples.size(); i++) {
+        EXPECT_EQ(samples[i], OFF_VALUE) << "at sample " << i;
+    }
+    EXPECT_TRUE(audio_synth_is_silent());
+}
+
+TEST_F(AudioSynth, RestStopsVoice) {
+    audio_synth_note_on(0, 440.0f, 0);
+    audio_synth_note_on(0, 0.0f, 500);
+    render(1000);
+
+    EXPECT_TRUE(audio_synth_is_silent());
+}
+
+TEST_F(AudioSynth, AllVoicesStayInRange) {
+    for (uint8_t i = 0; i < AUDIO_SYNTH_VOICES; i++) {
+        audio_synth_note_on(i, 200.0f, 0);
+    }
+    auto samples = render(SAMPLE_RATE / 10);
+
+    auto minmax = std::minmax_element(samples.begin(), samples.end());
+    EXPECT_GE(*minmax.first, OFF_VALUE - AMPLITUDE);
+    EXPECT_LE(*minmax.second, OFF_VALUE + AMPLITUDE);
+    // All voices in phase add up to (almost) the full amplitude
+    EXPECT_GT(*minmax.second, OFF_VALUE + AMPLITUDE * 9 / 10);
+}
+
+TEST_F(AudioSynth, LateEventsAreAppliedRightAway) {
+    render(1000);
+    audio_synth_note_on(0, 440.0f, 10);
+    render(100);
+
+    audio_synth_stats_t stats;
+    audio_synth_get_stats(&stats);
+    EXPECT_EQ(stats.late_events, 1);
+    EXPECT_FALSE(audio_synth_is_silent());
+}
+
+TEST_F(AudioSynth, FullQueueDropsEvents) {
+    for (int i = 0; i < AUDIO_SYNTH_EVENT_QUEUE_SIZE; i++) {
+        EXPECT_TRUE(audio_synth_note_on(0, 440.0f, i));
+    }
+    EXPECT_FALSE(audio_synth_note_on(0, 440.0f, 1000));
+
+    audio_synth_stats_t stats;
+    audio_synth_get_stats(&stats);
+    EXPECT_EQ(stats.dropped_events, 1);
+}
+
+TEST_F(AudioSynth, Melody) {
+    const float    notes[] = {523.25f, 659.25f, 783.99f, 1046.50f};
+    const uint32_t length  = audio_synth_ms_to_samples(150);
+
+    for (size_t i = 0; i < sizeof(notes) / sizeof(notes[0]); i++) {
+        audio_synth_note_on(0, notes[i], i * length);
+        // the root note keeps sounding on a second voice
+        audio_synth_note_on(1, i % 2 ? 0.0f : notes[0], i * length);
+    }
+    audio_synth_note_off(0, 4 * length);
+    auto samples = render(5 * length);
+    dump(samples);
+
+    EXPECT_TRUE(audio_synth_is_silent() || samples.back() == OFF_VALUE);
+    for (size_t i = 4 * length + AUDIO_SYNTH_RAMP_SAMPLES; i < samples.size(); i++) {
+        EXPECT_EQ(samples[i], OFF_VALUE) << "at sample " << i;
+    }
+}
+
+TEST_F(AudioSynth, CyclesPerBlockBenchmark) {
+    for (uint8_t i = 0; i < AUDIO_SYNTH_VOICES; i++) {
+        audio_synth_note_on(i, 220.0f * (i + 1), 0);
+    }
+    render(128);
+    audio_synth_reset_stats();
+
+    const int blocks = 10000;
+    uint16_t  block[128];
+    auto      start = std::chrono::steady_clock::now();
+    for (int i = 0; i < blocks; i++) {
+        audio_synth_render(block, 128);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    audio_synth_stats_t stats;
+    audio_synth_get_stats(&stats);
+    EXPECT_EQ(stats.blocks, blocks);
+    EXPECT_GT(stats.max_cycles, 0);
+
+    std::cout << "audio_synth_render: " << elapsed / blocks << " ns per block of 128 samples with " << AUDIO_SYNTH_VOICES << " voices (max " << stats.max_cycles << " ns)" << std::endl;
+    RecordProperty("ns_per_block", (int)(elapsed / blocks));
+}
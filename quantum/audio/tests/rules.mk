@@ -0,0 +1,10 @@
+audio_synth_DEFS := -DIGNORE_ATOMIC_BLOCK
+
+audio_synth_SRC := \
+	$(QUANTUM_PATH)/audio/tests/audio_synth_tests.cpp \
+	$(QUANTUM_PATH)/audio/tests/wav_dump.c \
+	$(QUANTUM_PATH)/audio/audio_synth.c \
+	$(QUANTUM_PATH)/audio/luts.c
+
+audio_synth_INC := \
+	$(QUANTUM_PATH)/audio
@@ -0,0 +1,47 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "wav_dump.h"
+#include <stdio.h>
+
+static void write_u16(FILE *file, uint16_t value) {
+    fputc(value & 0xFF, file);
+    fputc(value >> 8, file);
+}
+
+static void write_u32(FILE *file, uint32_t value) {
+    write_u16(file, value & 0xFFFF);
+    write_u16(file, value >> 16);
+}
+
+/**
+ * \brief Writes rendered samples as a mono 16bit PCM .wav file, for listening to or inspecting in an audio editor
+ *
+ * Samples are centered around off_value and scaled up from the 12bit DAC range.
+ */
+bool wav_dump(const char *path, const uint16_t *samples, uint32_t count, uint32_t sample_rate, uint16_t off_value) {
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        return false;
+    }
+
+    uint32_t data_size = count * 2;
+    fputs("RIFF", file);
+    write_u32(file, 36 + data_size);
+    fputs("WAVEfmt ", file);
+    write_u32(file, 16);              // format chunk size
+    write_u16(file, 1);               // PCM
+    write_u16(file, 1);               // mono
+    write_u32(file, sample_rate);     // sample rate
+    write_u32(file, sample_rate * 2); // byte rate
+    write_u16(file, 2);               // block align
+    write_u16(file, 16);              // bits per sample
+    fputs("data", file);
+    write_u32(file, data_size);
+
+    for (uint32_t i = 0; i < count; i++) {
+        write_u16(file, (uint16_t)(int16_t)(((int32_t)samples[i] - off_value) * 16));
+    }
+
+    return fclose(file) == 0;
+}
@@ -0,0 +1,9 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+bool wav_dump(const char *path, const uint16_t *samples, uint32_t count, uint32_t sample_rate, uint16_t off_value);
@@ -47,6 +47,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "audio.h"
 #endif /* AUDIO_ENABLE */
 
+#ifdef PROCESS_PROFILE_ENABLE
+#    include "process_profile.h"
+#endif
+
 static bool command_common(uint8_t code);
 static void command_common_help(void);
 static void print_version(void);
@@ -154,6 +158,10 @@ static void command_common_help(void) {
         STR(MAGIC_KEY_NKRO) ":	NKRO Toggle\n"
 #endif
 
+#ifdef PROCESS_PROFILE_ENABLE
+        STR(MAGIC_KEY_PROFILE) ":	Print Processor Profile\n"
+#endif
+
 #ifdef SLEEP_LED_ENABLE
         STR(MAGIC_KEY_SLEEP_LED) ":	Sleep LED Test\n"
 #endif
@@ -444,6 +452,15 @@ static bool command_common(uint8_t code) {
             print_status();
             break;
 
+#ifdef PROCESS_PROFILE_ENABLE
+
+        // print and reset processor profile
+        case MAGIC_KC(MAGIC_KEY_PROFILE):
+            process_profile_print();
+            process_profile_clear();
+            break;
+#endif
+
 #ifdef NKRO_ENABLE
 
         // NKRO toggle
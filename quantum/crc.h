@@ -29,6 +29,11 @@ typedef uint_fast8_t crc_t;
 typedef uint_least8_t crc_t;
 #endif
 
+/**
+ * Initial value of a CRC8, before any data.
+ */
+#define CRC8_INIT 0xff
+
 /**
  * Initialize crc subsystem.
  */
@@ -41,4 +46,16 @@ __attribute__((weak)) void crc_init(void);
  * \param[in] data_len Number of bytes in the \a data buffer.
  * \return             The calculated crc value.
  */
-__attribute__((weak)) uint8_t crc8(const void *data, size_t data_len);
\ No newline at end of file
+__attribute__((weak)) uint8_t crc8(const void *data, size_t data_len);
+
+/**
+ * Continue a CRC8 value over more data, for data that is not all in one buffer.
+ *
+ * Both implementations compute the same CRC-8, with polynomial 0x31 and initial value CRC8_INIT.
+ *
+ * \param[in] crc_value The CRC8 of the data so far, or CRC8_INIT.
+ * \param[in] data      Pointer to a buffer of \a data_len bytes.
+ * \param[in] data_len  Number of bytes in the \a data buffer.
+ * \return              The calculated crc value.
+ */
+uint8_t crc8_update(uint8_t crc_value, const void *data, size_t data_len);
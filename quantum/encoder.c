@@ -23,8 +23,8 @@
 // for memcpy
 #include <string.h>
 
-#ifndef ENCODER_MAP_KEY_DELAY
-#    define ENCODER_MAP_KEY_DELAY 2
+#ifdef ENCODER_INTERRUPTS
+#    include "atomic_util.h"
 #endif
 
 #if !defined(ENCODER_RESOLUTIONS) && !defined(ENCODER_RESOLUTION)
@@ -55,6 +55,10 @@ static int8_t encoder_LUT[] = {0, -1, 1, 0, 1, 0, 0, -1, -1, 0, 0, 1, 0, 1, -1,
 
 static uint8_t encoder_state[NUM_ENCODERS]  = {0};
 static int8_t  encoder_pulses[NUM_ENCODERS] = {0};
+#ifdef ENCODER_INTERRUPTS
+// detents decoded in interrupt context, not yet handled by encoder_read()
+static volatile int8_t encoder_steps[NUM_ENCODERS] = {0};
+#endif
 
 // encoder counts
 static uint8_t thisCount;
@@ -67,6 +71,21 @@ static uint8_t thatCount;
 
 static uint8_t encoder_value[NUM_ENCODERS] = {0};
 
+#ifdef ENCODER_MAP_ENABLE
+// consecutive detents of one encoder in one direction share an entry
+typedef struct {
+    uint8_t index;
+    bool    clockwise;
+    uint8_t count;
+} encoder_map_event_t;
+
+static encoder_map_event_t encoder_map_queue[ENCODER_MAP_QUEUE_SIZE];
+static uint8_t             encoder_map_head    = 0;
+static uint8_t             encoder_map_count   = 0;
+static bool                encoder_map_pressed = false;
+static uint16_t            encoder_map_timer   = 0;
+#endif // ENCODER_MAP_ENABLE
+
 __attribute__((weak)) void encoder_wait_pullup_charge(void) {
     wait_us(100);
 }
@@ -79,6 +98,12 @@ __attribute__((weak)) bool encoder_update_kb(uint8_t index, bool clockwise) {
     return encoder_update_user(index, clockwise);
 }
 
+#if defined(ENCODER_INTERRUPTS) && defined(PROTOCOL_CHIBIOS)
+static void encoder_pal_callback(void *arg) {
+    encoder_interrupt_handler((uint8_t)(uintptr_t)arg);
+}
+#endif
+
 void encoder_init(void) {
 #ifdef SPLIT_KEYBOARD
     thisHand  = isLeftHand ? 0 : NUM_ENCODERS_LEFT;
@@ -97,6 +122,15 @@ void encoder_init(void) {
     memset(encoder_value, 0, sizeof(encoder_value));
     memset(encoder_state, 0, sizeof(encoder_state));
     memset(encoder_pulses, 0, sizeof(encoder_pulses));
+#    ifdef ENCODER_MAP_ENABLE
+    encoder_map_head    = 0;
+    encoder_map_count   = 0;
+    encoder_map_pressed = false;
+    encoder_map_timer   = 0;
+#    endif
+#    ifdef ENCODER_INTERRUPTS
+    memset((void *)encoder_steps, 0, sizeof(encoder_steps));
+#    endif
     static const pin_t encoders_pad_a_left[] = ENCODERS_PAD_A;
     static const pin_t encoders_pad_b_left[] = ENCODERS_PAD_B;
     for (uint8_t i = 0; i < thisCount; i++) {
@@ -137,21 +171,62 @@ void encoder_init(void) {
     for (uint8_t i = 0; i < thisCount; i++) {
         encoder_state[i] = (readPin(encoders_pad_a[i]) << 0) | (readPin(encoders_pad_b[i]) << 1);
     }
+
+#if defined(ENCODER_INTERRUPTS) && defined(PROTOCOL_CHIBIOS)
+    for (uint8_t i = 0; i < thisCount; i++) {
+        palEnableLineEvent(encoders_pad_a[i], PAL_EVENT_MODE_BOTH_EDGES);
+        palSetLineCallback(encoders_pad_a[i], encoder_pal_callback, (void *)(uintptr_t)i);
+        palEnableLineEvent(encoders_pad_b[i], PAL_EVENT_MODE_BOTH_EDGES);
+        palSetLineCallback(encoders_pad_b[i], encoder_pal_callback, (void *)(uintptr_t)i);
+    }
+#endif
 }
 
 #ifdef ENCODER_MAP_ENABLE
 static void encoder_exec_mapping(uint8_t index, bool clockwise) {
-    // The delays below cater for Windows and its wonderful requirements.
-    action_exec(clockwise ? ENCODER_CW_EVENT(index, true) : ENCODER_CCW_EVENT(index, true));
-    wait_ms(ENCODER_MAP_KEY_DELAY);
-    action_exec(clockwise ? ENCODER_CW_EVENT(index, false) : ENCODER_CCW_EVENT(index, false));
-    wait_ms(ENCODER_MAP_KEY_DELAY);
+    if (encoder_map_count > 0) {
+        encoder_map_event_t *last = &encoder_map_queue[(encoder_map_head + encoder_map_count - 1) % ENCODER_MAP_QUEUE_SIZE];
+        if (last->index == index && last->clockwise == clockwise && last->count < UINT8_MAX) {
+            last->count++;
+            return;
+        }
+    }
+    if (encoder_map_count == ENCODER_MAP_QUEUE_SIZE) {
+        dprintf("encoder map queue full, dropping step\n");
+        return;
+    }
+    encoder_map_queue[(encoder_map_head + encoder_map_count) % ENCODER_MAP_QUEUE_SIZE] = (encoder_map_event_t){.index = index, .clockwise = clockwise, .count = 1};
+    encoder_map_count++;
+}
+
+static void encoder_map_task(void) {
+    // The delays between press and release cater for Windows and its wonderful requirements.
+    if (encoder_map_count == 0 || timer_elapsed(encoder_map_timer) < ENCODER_MAP_KEY_DELAY) {
+        return;
+    }
+
+    encoder_map_event_t *event = &encoder_map_queue[encoder_map_head];
+    encoder_map_pressed        = !encoder_map_pressed;
+    action_exec(event->clockwise ? ENCODER_CW_EVENT(event->index, encoder_map_pressed) : ENCODER_CCW_EVENT(event->index, encoder_map_pressed));
+    if (!encoder_map_pressed && --event->count == 0) {
+        encoder_map_head = (encoder_map_head + 1) % ENCODER_MAP_QUEUE_SIZE;
+        encoder_map_count--;
+    }
+    encoder_map_timer = timer_read();
 }
 #endif // ENCODER_MAP_ENABLE
 
-static bool encoder_update(uint8_t index, uint8_t state) {
-    bool    changed = false;
-    uint8_t i       = index;
+static void encoder_exec(uint8_t index, bool clockwise) {
+#ifdef ENCODER_MAP_ENABLE
+    encoder_exec_mapping(index, clockwise);
+#else  // ENCODER_MAP_ENABLE
+    encoder_update_kb(index, clockwise);
+#endif // ENCODER_MAP_ENABLE
+}
+
+// Turns a new pin state into detents, safe to call from interrupt context
+static int8_t encoder_decode(uint8_t i, uint8_t state) {
+    int8_t step = 0;
 
 #ifdef ENCODER_RESOLUTIONS
     const uint8_t resolution = encoder_resolutions[i];
@@ -159,9 +234,6 @@ static bool encoder_update(uint8_t index, uint8_t state) {
     const uint8_t resolution = ENCODER_RESOLUTION;
 #endif
 
-#ifdef SPLIT_KEYBOARD
-    index += thisHand;
-#endif
     encoder_pulses[i] += encoder_LUT[state & 0xF];
 
 #ifdef ENCODER_DEFAULT_POS
@@ -170,14 +242,7 @@ static bool encoder_update(uint8_t index, uint8_t state) {
 #else
     if (encoder_pulses[i] >= resolution) {
 #endif
-
-            encoder_value[index]++;
-            changed = true;
-#ifdef ENCODER_MAP_ENABLE
-            encoder_exec_mapping(index, ENCODER_COUNTER_CLOCKWISE);
-#else  // ENCODER_MAP_ENABLE
-        encoder_update_kb(index, ENCODER_COUNTER_CLOCKWISE);
-#endif // ENCODER_MAP_ENABLE
+            step = 1;
         }
 
 #ifdef ENCODER_DEFAULT_POS
@@ -185,32 +250,69 @@ static bool encoder_update(uint8_t index, uint8_t state) {
 #else
     if (encoder_pulses[i] <= -resolution) { // direction is arbitrary here, but this clockwise
 #endif
-            encoder_value[index]--;
-            changed = true;
-#ifdef ENCODER_MAP_ENABLE
-            encoder_exec_mapping(index, ENCODER_CLOCKWISE);
-#else  // ENCODER_MAP_ENABLE
-        encoder_update_kb(index, ENCODER_CLOCKWISE);
-#endif // ENCODER_MAP_ENABLE
+            step = -1;
         }
         encoder_pulses[i] %= resolution;
 #ifdef ENCODER_DEFAULT_POS
         encoder_pulses[i] = 0;
     }
 #endif
+    return step;
+}
+
+static bool encoder_update(uint8_t index, int8_t steps) {
+    bool changed = steps != 0;
+
+#ifdef SPLIT_KEYBOARD
+    index += thisHand;
+#endif
+    for (; steps > 0; steps--) {
+        encoder_value[index]++;
+        encoder_exec(index, ENCODER_COUNTER_CLOCKWISE);
+    }
+    for (; steps < 0; steps++) {
+        encoder_value[index]--;
+        encoder_exec(index, ENCODER_CLOCKWISE);
+    }
     return changed;
 }
 
+#ifdef ENCODER_INTERRUPTS
+void encoder_interrupt_handler(uint8_t index) {
+    uint8_t new_status = (readPin(encoders_pad_a[index]) << 0) | (readPin(encoders_pad_b[index]) << 1);
+    if ((encoder_state[index] & 0x3) != new_status) {
+        encoder_state[index] <<= 2;
+        encoder_state[index] |= new_status;
+        int8_t step = encoder_decode(index, encoder_state[index]);
+        if ((step > 0 && encoder_steps[index] < INT8_MAX) || (step < 0 && encoder_steps[index] > INT8_MIN)) {
+            encoder_steps[index] += step;
+        }
+    }
+}
+#endif
+
 bool encoder_read(void) {
     bool changed = false;
     for (uint8_t i = 0; i < thisCount; i++) {
+#ifdef ENCODER_INTERRUPTS
+        int8_t steps;
+        ATOMIC_BLOCK_FORCEON {
+            steps            = encoder_steps[i];
+            encoder_steps[i] = 0;
+        }
+        changed |= encoder_update(i, steps);
+#else
         uint8_t new_status = (readPin(encoders_pad_a[i]) << 0) | (readPin(encoders_pad_b[i]) << 1);
         if ((encoder_state[i] & 0x3) != new_status) {
             encoder_state[i] <<= 2;
             encoder_state[i] |= new_status;
-            changed |= encoder_update(i, encoder_state[i]);
+            changed |= encoder_update(i, encoder_decode(i, encoder_state[i]));
         }
+#endif
     }
+#ifdef ENCODER_MAP_ENABLE
+    encoder_map_task();
+#endif
     return changed;
 }
 
@@ -230,21 +332,13 @@ void encoder_update_raw(uint8_t *slave_state) {
             delta--;
             encoder_value[index]++;
             changed = true;
-#    ifdef ENCODER_MAP_ENABLE
-            encoder_exec_mapping(index, ENCODER_COUNTER_CLOCKWISE);
-#    else  // ENCODER_MAP_ENABLE
-            encoder_update_kb(index, ENCODER_COUNTER_CLOCKWISE);
-#    endif // ENCODER_MAP_ENABLE
+            encoder_exec(index, ENCODER_COUNTER_CLOCKWISE);
         }
         while (delta < 0) {
             delta++;
             encoder_value[index]--;
             changed = true;
-#    ifdef ENCODER_MAP_ENABLE
-            encoder_exec_mapping(index, ENCODER_CLOCKWISE);
-#    else  // ENCODER_MAP_ENABLE
-            encoder_update_kb(index, ENCODER_CLOCKWISE);
-#    endif // ENCODER_MAP_ENABLE
+            encoder_exec(index, ENCODER_CLOCKWISE);
         }
     }
 
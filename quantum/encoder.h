@@ -26,6 +26,10 @@ bool encoder_read(void);
 bool encoder_update_kb(uint8_t index, bool clockwise);
 bool encoder_update_user(uint8_t index, bool clockwise);
 
+#ifdef ENCODER_INTERRUPTS
+void encoder_interrupt_handler(uint8_t index);
+#endif
+
 #ifdef SPLIT_KEYBOARD
 
 void encoder_state_raw(uint8_t* slave_state);
@@ -57,6 +61,13 @@ void encoder_update_raw(uint8_t* slave_state);
 #define NUM_ENCODERS_MAX_PER_SIDE MAX(NUM_ENCODERS_LEFT, NUM_ENCODERS_RIGHT)
 
 #ifdef ENCODER_MAP_ENABLE
+#    ifndef ENCODER_MAP_KEY_DELAY
+#        define ENCODER_MAP_KEY_DELAY 2
+#    endif
+#    ifndef ENCODER_MAP_QUEUE_SIZE
+#        define ENCODER_MAP_QUEUE_SIZE 16
+#    endif
+
 #    define ENCODER_CCW_CW(ccw, cw) \
         { (cw), (ccw) }
 extern const uint16_t encoder_map[][NUM_ENCODERS][2];
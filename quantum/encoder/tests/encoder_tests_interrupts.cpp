@@ -0,0 +1,99 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <vector>
+#include <algorithm>
+#include <stdio.h>
+
+extern "C" {
+#include "encoder.h"
+#include "encoder/tests/mock.h"
+}
+
+struct update {
+    int8_t index;
+    bool   clockwise;
+};
+
+uint8_t updates_array_idx = 0;
+update  updates[32];
+
+bool encoder_update_kb(uint8_t index, bool clockwise) {
+    updates[updates_array_idx % 32] = {index, clockwise};
+    updates_array_idx++;
+    return true;
+}
+
+// Stands in for the pin change interrupt firing on every edge
+void setAndInterrupt(pin_t pin, bool val) {
+    setPin(pin, val);
+    encoder_interrupt_handler(0);
+}
+
+class EncoderInterruptTest : public ::testing::Test {};
+
+TEST_F(EncoderInterruptTest, TestStepsAreDeferredToRead) {
+    updates_array_idx = 0;
+    encoder_init();
+    setAndInterrupt(0, false);
+    setAndInterrupt(1, false);
+    setAndInterrupt(0, true);
+    setAndInterrupt(1, true);
+    EXPECT_EQ(updates_array_idx, 0);
+
+    EXPECT_TRUE(encoder_read());
+    EXPECT_EQ(updates_array_idx, 1);
+    EXPECT_EQ(updates[0].index, 0);
+    EXPECT_EQ(updates[0].clockwise, true);
+
+    EXPECT_FALSE(encoder_read());
+    EXPECT_EQ(updates_array_idx, 1);
+}
+
+TEST_F(EncoderInterruptTest, TestFastSpinBetweenReadsIsNotLost) {
+    updates_array_idx = 0;
+    encoder_init();
+    // Three detents clockwise and one back, all while the main loop is busy
+    for (int i = 0; i < 3; i++) {
+        setAndInterrupt(0, false);
+        setAndInterrupt(1, false);
+        setAndInterrupt(0, true);
+        setAndInterrupt(1, true);
+    }
+    setAndInterrupt(1, false);
+    setAndInterrupt(0, false);
+    setAndInterrupt(1, true);
+    setAndInterrupt(0, true);
+
+    EXPECT_TRUE(encoder_read());
+    EXPECT_EQ(updates_array_idx, 2);
+    EXPECT_EQ(updates[0].clockwise, true);
+    EXPECT_EQ(updates[1].clockwise, true);
+}
+
+TEST_F(EncoderInterruptTest, TestPollingDoesNotDecode) {
+    updates_array_idx = 0;
+    encoder_init();
+    // Pin changes without an interrupt are not picked up by encoder_read
+    setPin(0, false);
+    setPin(1, false);
+    setPin(0, true);
+    setPin(1, true);
+    EXPECT_FALSE(encoder_read());
+    EXPECT_EQ(updates_array_idx, 0);
+}
@@ -0,0 +1,115 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <vector>
+#include <stdio.h>
+
+extern "C" {
+#include "encoder.h"
+#include "encoder/tests/mock.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+std::vector<keyevent_t> events;
+
+extern "C" void action_exec(keyevent_t event) {
+    events.push_back(event);
+}
+
+void setAndRead(pin_t pin, bool val) {
+    setPin(pin, val);
+    encoder_read();
+}
+
+void turn(bool clockwise) {
+    setAndRead(clockwise ? 0 : 1, false);
+    setAndRead(clockwise ? 1 : 0, false);
+    setAndRead(clockwise ? 0 : 1, true);
+    setAndRead(clockwise ? 1 : 0, true);
+}
+
+class EncoderMapTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        events.clear();
+        set_time(0);
+        encoder_init();
+    }
+
+    // Lets the queue drain, one press or release per ENCODER_MAP_KEY_DELAY
+    void drain() {
+        for (int i = 0; i < 1000; i++) {
+            advance_time(ENCODER_MAP_KEY_DELAY);
+            encoder_read();
+        }
+    }
+
+    void expect_taps(size_t from, size_t taps, uint8_t row) {
+        ASSERT_GE(events.size(), from + taps * 2);
+        for (size_t i = 0; i < taps * 2; i++) {
+            EXPECT_EQ(events[from + i].key.row, row) << "event " << from + i;
+            EXPECT_EQ(events[from + i].key.col, 0) << "event " << from + i;
+            EXPECT_EQ(events[from + i].pressed, i % 2 == 0) << "event " << from + i;
+        }
+    }
+};
+
+TEST_F(EncoderMapTest, TestSpinPastQueueSizeSendsEveryTap) {
+    const size_t detents = ENCODER_MAP_QUEUE_SIZE * 3;
+    for (size_t i = 0; i < detents; i++) {
+        turn(true);
+    }
+    EXPECT_TRUE(events.empty());
+
+    drain();
+    EXPECT_EQ(events.size(), detents * 2);
+    expect_taps(0, detents, KEYLOC_ENCODER_CW);
+}
+
+TEST_F(EncoderMapTest, TestDirectionChangesKeepTheirOrder) {
+    for (int i = 0; i < ENCODER_MAP_QUEUE_SIZE; i++) {
+        turn(true);
+    }
+    for (int i = 0; i < ENCODER_MAP_QUEUE_SIZE; i++) {
+        turn(false);
+    }
+    turn(true);
+
+    drain();
+    EXPECT_EQ(events.size(), (ENCODER_MAP_QUEUE_SIZE * 2 + 1) * 2);
+    expect_taps(0, ENCODER_MAP_QUEUE_SIZE, KEYLOC_ENCODER_CW);
+    expect_taps(ENCODER_MAP_QUEUE_SIZE * 2, ENCODER_MAP_QUEUE_SIZE, KEYLOC_ENCODER_CCW);
+    expect_taps(ENCODER_MAP_QUEUE_SIZE * 4, 1, KEYLOC_ENCODER_CW);
+}
+
+TEST_F(EncoderMapTest, TestTurnWhileTapIsPressedIsNotLost) {
+    turn(true);
+    advance_time(ENCODER_MAP_KEY_DELAY);
+    encoder_read();
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_TRUE(events[0].pressed);
+
+    // The queued entry is half sent, the new detent joins it
+    turn(true);
+
+    drain();
+    EXPECT_EQ(events.size(), 4u);
+    expect_taps(0, 2, KEYLOC_ENCODER_CW);
+}
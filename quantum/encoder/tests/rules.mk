@@ -7,6 +7,15 @@ encoder_SRC := \
 	$(QUANTUM_PATH)/encoder/tests/encoder_tests.cpp \
 	$(QUANTUM_PATH)/encoder.c
 
+encoder_interrupts_DEFS := -DENCODER_TESTS -DENCODER_ENABLE -DENCODER_MOCK_SINGLE -DENCODER_INTERRUPTS -DIGNORE_ATOMIC_BLOCK
+encoder_interrupts_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock.h
+
+encoder_interrupts_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/encoder/tests/mock.c \
+	$(QUANTUM_PATH)/encoder/tests/encoder_tests_interrupts.cpp \
+	$(QUANTUM_PATH)/encoder.c
+
 encoder_split_left_eq_right_DEFS := -DENCODER_TESTS -DENCODER_ENABLE -DENCODER_MOCK_SPLIT
 encoder_split_left_eq_right_INC := $(QUANTUM_PATH)/split_common
 encoder_split_left_eq_right_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock_split_left_eq_right.h
@@ -56,3 +65,12 @@ encoder_split_no_right_SRC := \
 	$(QUANTUM_PATH)/encoder/tests/mock_split.c \
 	$(QUANTUM_PATH)/encoder/tests/encoder_tests_split_no_right.cpp \
 	$(QUANTUM_PATH)/encoder.c
+
+encoder_map_DEFS := -DENCODER_TESTS -DENCODER_ENABLE -DENCODER_MOCK_SINGLE -DENCODER_MAP_ENABLE
+encoder_map_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock.h
+
+encoder_map_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/encoder/tests/mock.c \
+	$(QUANTUM_PATH)/encoder/tests/encoder_tests_map.cpp \
+	$(QUANTUM_PATH)/encoder.c
@@ -1,4 +1,5 @@
 #include "joystick.h"
+#include "action_util.h"
 
 // clang-format off
 joystick_t joystick_status = {
@@ -20,6 +21,7 @@ void send_joystick_packet(joystick_t *joystick);
 
 void joystick_flush(void) {
     if ((joystick_status.status & JS_UPDATED) > 0) {
+        flush_keyboard_report();
         send_joystick_packet(&joystick_status);
         joystick_status.status &= ~JS_UPDATED;
     }
@@ -111,6 +111,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef CAPS_WORD_ENABLE
 #    include "caps_word.h"
 #endif
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
+#ifdef PROCESS_PROFILE_ENABLE
+#    include "process_profile.h"
+#endif
+#ifdef MATRIX_TRACE_ENABLE
+#    include "matrix_trace.h"
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -411,6 +420,10 @@ void keyboard_init(void) {
     pointing_device_init();
 #endif
 
+#ifdef PROCESS_PROFILE_ENABLE
+    process_profile_init();
+#endif
+
 #if defined(DEBUG_MATRIX_SCAN_RATE) && defined(CONSOLE_ENABLE)
     debug_enable = true;
 #endif
@@ -424,6 +437,9 @@ void keyboard_init(void) {
  * This is differnet than keycode events as no layer processing, or filtering occurs.
  */
 void switch_events(uint8_t row, uint8_t col, bool pressed) {
+#if defined(MATRIX_TRACE_ENABLE)
+    matrix_trace_record(row, col, pressed);
+#endif
 #if defined(LED_MATRIX_ENABLE)
     process_led_matrix(row, col, pressed);
 #endif
@@ -470,12 +486,30 @@ static bool matrix_task(void) {
         return matrix_changed;
     }
 
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_mark(LATENCY_STAGE_DEBOUNCE);
+#endif
+
     if (debug_config.matrix) {
         matrix_print();
     }
 
     const bool process_keypress = should_process_keypress();
 
+#ifdef BATCH_KEYBOARD_REPORTS
+    // All changes of a scan share the same timestamp
+    const uint16_t scan_time = timer_read() | 1;
+    // A single change has nothing to be batched with
+    bool batch = false;
+    for (uint8_t row = 0, changes = 0; row < MATRIX_ROWS && process_keypress && !batch; row++) {
+        const matrix_row_t row_changes = matrix_get_row(row) ^ matrix_previous[row];
+        if (row_changes) {
+            changes += (row_changes & (row_changes - 1)) ? 2 : 1;
+            batch = changes > 1;
+        }
+    }
+#endif
+
     for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
         const matrix_row_t current_row = matrix_get_row(row);
         const matrix_row_t row_changes = current_row ^ matrix_previous[row];
@@ -490,7 +524,14 @@ static bool matrix_task(void) {
                 const bool key_pressed = current_row & col_mask;
 
                 if (process_keypress) {
+#ifdef BATCH_KEYBOARD_REPORTS
+                    if (batch) {
+                        begin_keyboard_report_batch();
+                    }
+                    action_exec((keyevent_t){.key = MAKE_KEYPOS(row, col), .pressed = key_pressed, .time = scan_time});
+#else
                     action_exec(MAKE_KEYEVENT(row, col, key_pressed));
+#endif
                 }
 
                 switch_events(row, col, key_pressed);
@@ -500,6 +541,12 @@ static bool matrix_task(void) {
         matrix_previous[row] = current_row;
     }
 
+#ifdef BATCH_KEYBOARD_REPORTS
+    if (batch) {
+        end_keyboard_report_batch();
+    }
+#endif
+
     return matrix_changed;
 }
 
@@ -545,6 +592,14 @@ void quantum_task(void) {
     sequencer_task();
 #endif
 
+#ifdef DYNAMIC_MACRO_ENABLE
+    dynamic_macro_task();
+#endif
+
+#if defined(LEADER_ENABLE) && defined(LEADER_SEQUENCE_COUNT)
+    leader_task();
+#endif
+
 #ifdef TAP_DANCE_ENABLE
     tap_dance_task();
 #endif
@@ -576,6 +631,18 @@ void quantum_task(void) {
 #ifdef SECURE_ENABLE
     secure_task();
 #endif
+
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_task();
+#endif
+
+#ifdef VIA_ENABLE
+    via_matrix_stream_task();
+#endif
+
+#ifdef MATRIX_TRACE_ENABLE
+    matrix_trace_task();
+#endif
 }
 
 /** \brief Main task that is repeatedly called as fast as possible. */
@@ -0,0 +1,208 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "latency_trace.h"
+#include "timer.h"
+#include "debug.h"
+#include "print.h"
+
+#ifndef LATENCY_TRACE_BUFFER_SIZE
+#    define LATENCY_TRACE_BUFFER_SIZE 32
+#endif
+
+#ifndef LATENCY_TRACE_TIMEOUT
+#    define LATENCY_TRACE_TIMEOUT 1000
+#endif
+
+#if LATENCY_TRACE_BUFFER_SIZE > 255
+#    error LATENCY_TRACE_BUFFER_SIZE must be less than 256
+#endif
+
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+// Use the system tick for sub-millisecond resolution where available
+typedef systime_t trace_time_t;
+#    define TRACE_NOW() chVTGetSystemTimeX()
+#    define TRACE_ELAPSED_US(start) ((uint32_t)TIME_I2US(chTimeDiffX((start), chVTGetSystemTimeX())))
+#    define TRACE_RESOLUTION_US ((uint32_t)TIME_I2US(1))
+// latency_trace_mark() also runs in the USB IN completion interrupt, so the trace state is only touched with the system locked
+#    define TRACE_LOCK() syssts_t trace_lock_status = chSysGetStatusAndLockX()
+#    define TRACE_UNLOCK() chSysRestoreStatusX(trace_lock_status)
+// The USB IN completion callback marks when the host actually collected the report
+#    ifndef LATENCY_TRACE_FINAL_STAGE
+#        define LATENCY_TRACE_FINAL_STAGE LATENCY_STAGE_USB_IN
+#    endif
+#else
+typedef uint32_t trace_time_t;
+#    define TRACE_NOW() timer_read32()
+#    define TRACE_ELAPSED_US(start) (timer_elapsed32(start) * 1000)
+#    define TRACE_RESOLUTION_US 1000
+// Without the USB IN stage every caller runs in the main loop
+#    define TRACE_LOCK()
+#    define TRACE_UNLOCK()
+#    ifndef LATENCY_TRACE_FINAL_STAGE
+#        define LATENCY_TRACE_FINAL_STAGE LATENCY_STAGE_HOST_SEND
+#    endif
+#endif
+
+#define TRACE_UNREACHED UINT32_MAX
+
+static trace_time_t      trace_start;
+static volatile uint32_t trace_stages[LATENCY_STAGE_COUNT];
+static volatile bool     trace_active   = false;
+static volatile bool     trace_complete = false;
+
+static uint32_t trace_buffer[LATENCY_TRACE_BUFFER_SIZE][LATENCY_STAGE_COUNT];
+static uint8_t  trace_head  = 0;
+static uint8_t  trace_used  = 0;
+static uint32_t trace_count = 0;
+
+static void trace_begin(void) {
+    for (uint8_t i = 0; i < LATENCY_STAGE_COUNT; i++) {
+        trace_stages[i] = TRACE_UNREACHED;
+    }
+    trace_start  = TRACE_NOW();
+    trace_active = true;
+}
+
+static void trace_reset(void) {
+    trace_active   = false;
+    trace_complete = false;
+}
+
+static void trace_mark(latency_stage_t stage) {
+    if (trace_complete) {
+        // Wait for latency_trace_task to commit the previous event
+        return;
+    }
+
+    if (!trace_active) {
+        // Only a matrix change can start a new event
+        if (stage > LATENCY_STAGE_DEBOUNCE) {
+            return;
+        }
+        trace_begin();
+    }
+
+    if (trace_stages[stage] != TRACE_UNREACHED) {
+        return;
+    }
+
+    // A USB IN completion is only meaningful for a report we have seen go out
+    if (stage == LATENCY_STAGE_USB_IN && trace_stages[LATENCY_STAGE_HOST_SEND] == TRACE_UNREACHED) {
+        return;
+    }
+
+    trace_stages[stage] = TRACE_ELAPSED_US(trace_start);
+
+    if (stage == LATENCY_TRACE_FINAL_STAGE) {
+        trace_complete = true;
+    }
+}
+
+void latency_trace_mark(latency_stage_t stage) {
+    TRACE_LOCK();
+    trace_mark(stage);
+    TRACE_UNLOCK();
+}
+
+void latency_trace_task(void) {
+    uint32_t stages[LATENCY_STAGE_COUNT];
+    bool     complete = false;
+
+    TRACE_LOCK();
+    if (trace_complete) {
+        for (uint8_t i = 0; i < LATENCY_STAGE_COUNT; i++) {
+            stages[i] = trace_stages[i];
+        }
+        complete = true;
+        trace_reset();
+    } else if (trace_active) {
+        // Events that never produce a report (layer keys, held mods, ...) are dropped
+        if (TRACE_ELAPSED_US(trace_start) >= (uint32_t)LATENCY_TRACE_TIMEOUT * 1000) {
+            trace_reset();
+        }
+    }
+    TRACE_UNLOCK();
+
+    if (complete) {
+        for (uint8_t i = 0; i < LATENCY_STAGE_COUNT; i++) {
+            trace_buffer[trace_head][i] = stages[i];
+        }
+        trace_head = (trace_head + 1) % LATENCY_TRACE_BUFFER_SIZE;
+        if (trace_used < LATENCY_TRACE_BUFFER_SIZE) {
+            trace_used++;
+        }
+        trace_count++;
+
+        if (debug_enable && (trace_count % LATENCY_TRACE_BUFFER_SIZE) == 0) {
+            latency_trace_print();
+        }
+    }
+}
+
+void latency_trace_clear(void) {
+    TRACE_LOCK();
+    trace_reset();
+    TRACE_UNLOCK();
+    trace_head  = 0;
+    trace_used  = 0;
+    trace_count = 0;
+}
+
+uint32_t latency_trace_get_count(void) {
+    return trace_count;
+}
+
+uint32_t latency_trace_get_resolution(void) {
+    return TRACE_RESOLUTION_US;
+}
+
+void latency_trace_get_stats(latency_stage_t stage, latency_stats_t *stats) {
+    uint32_t values[LATENCY_TRACE_BUFFER_SIZE];
+    uint8_t  count = 0;
+
+    // Insertion sort, the buffer is small and this is not called from the hot path
+    for (uint8_t i = 0; i < trace_used; i++) {
+        uint32_t value = trace_buffer[i][stage];
+        if (value == TRACE_UNREACHED) {
+            continue;
+        }
+        uint8_t j = count++;
+        for (; j > 0 && values[j - 1] > value; j--) {
+            values[j] = values[j - 1];
+        }
+        values[j] = value;
+    }
+
+    stats->count = count;
+    if (count == 0) {
+        stats->p50 = stats->p99 = stats->max = 0;
+        return;
+    }
+    stats->p50 = values[(count - 1) * 50 / 100];
+    stats->p99 = values[(count - 1) * 99 / 100];
+    stats->max = values[count - 1];
+}
+
+void latency_trace_print(void) {
+#ifdef CONSOLE_ENABLE
+    static const char *const stage_names[LATENCY_STAGE_COUNT] = {
+        [LATENCY_STAGE_RAW_MATRIX]     = "raw matrix",
+        [LATENCY_STAGE_DEBOUNCE]       = "debounce",
+        [LATENCY_STAGE_ACTION_EXEC]    = "action_exec",
+        [LATENCY_STAGE_PROCESS_RECORD] = "process_record",
+        [LATENCY_STAGE_HOST_SEND]      = "host send",
+        [LATENCY_STAGE_USB_IN]         = "usb in",
+    };
+
+    dprintf("latency trace: %lu events, %luus resolution\n", (unsigned long)trace_count, (unsigned long)TRACE_RESOLUTION_US);
+    for (uint8_t i = 0; i < LATENCY_STAGE_COUNT; i++) {
+        latency_stats_t stats;
+        latency_trace_get_stats(i, &stats);
+        if (stats.count) {
+            dprintf("  %-14s p50 %6luus p99 %6luus max %6luus\n", stage_names[i], (unsigned long)stats.p50, (unsigned long)stats.p99, (unsigned long)stats.max);
+        }
+    }
+#endif
+}
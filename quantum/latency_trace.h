@@ -0,0 +1,72 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/** \file
+ *
+ * Lightweight tracer that timestamps a single key event as it travels from the
+ * matrix, through the action and process_record machinery, out to the host.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** \brief Stages a traced key event passes through, in order
+ */
+typedef enum {
+    LATENCY_STAGE_RAW_MATRIX,     ///< raw (pre-debounce) matrix change detected
+    LATENCY_STAGE_DEBOUNCE,       ///< debounced matrix change seen by matrix_task
+    LATENCY_STAGE_ACTION_EXEC,    ///< key event handed to action_exec
+    LATENCY_STAGE_PROCESS_RECORD, ///< record entered the process_record chain
+    LATENCY_STAGE_HOST_SEND,      ///< keyboard report handed to the host driver
+    LATENCY_STAGE_USB_IN,         ///< keyboard report collected by the host
+    LATENCY_STAGE_COUNT,
+} latency_stage_t;
+
+/** \brief Summary of a single stage over the traced events currently buffered
+ *
+ * All values are in microseconds, relative to the start of each event, and
+ * are multiples of latency_trace_get_resolution().
+ */
+typedef struct {
+    uint8_t  count;
+    uint32_t p50;
+    uint32_t p99;
+    uint32_t max;
+} latency_stats_t;
+
+/** \brief Flag that the current key event has reached the given stage
+ *
+ * The first matrix stage marked starts a new trace. Later stages are only
+ * recorded while a trace is in flight, and only the first hit of each stage
+ * counts. Safe to call from the USB IN completion interrupt.
+ */
+void latency_trace_mark(latency_stage_t stage);
+
+/** \brief Commit completed traces and expire stale ones
+ */
+void latency_trace_task(void);
+
+/** \brief Discard all buffered traces
+ */
+void latency_trace_clear(void);
+
+/** \brief Number of completed traces since the last clear
+ */
+uint32_t latency_trace_get_count(void);
+
+/** \brief Resolution of the timestamps in microseconds
+ *
+ * The ChibiOS system tick period, or 1000 on platforms with only a
+ * millisecond timer.
+ */
+uint32_t latency_trace_get_resolution(void);
+
+/** \brief Compute p50/p99/max over the buffered traces for the given stage
+ */
+void latency_trace_get_stats(latency_stage_t stage, latency_stats_t *stats);
+
+/** \brief Dump per-stage p50/p99/max to the console
+ */
+void latency_trace_print(void);
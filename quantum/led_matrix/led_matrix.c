@@ -96,6 +96,9 @@ uint8_t g_led_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
 last_hit_t g_last_hit_tracker;
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
+#ifdef LED_MATRIX_POLAR_ENABLED
+led_polar_t g_led_polar[DRIVER_LED_TOTAL];
+#endif // LED_MATRIX_POLAR_ENABLED
 
 // internals
 static bool            suspend_state     = false;
@@ -103,6 +106,10 @@ static uint8_t         led_last_enable   = UINT8_MAX;
 static uint8_t         led_last_effect   = UINT8_MAX;
 static effect_params_t led_effect_params = {0, LED_FLAG_ALL, false};
 static led_task_states led_task_state    = SYNCING;
+// the last value handed to the driver for each LED, so unchanged frames are not flushed
+static uint8_t led_frame[DRIVER_LED_TOTAL];
+static bool    led_frame_valid   = false;
+static bool    led_frame_changed = false;
 #if LED_DISABLE_TIMEOUT > 0
 static uint32_t led_anykey_timer;
 #endif // LED_DISABLE_TIMEOUT > 0
@@ -165,6 +172,11 @@ void led_matrix_set_value(int index, uint8_t value) {
 #ifdef USE_CIE1931_CURVE
     value = pgm_read_byte(&CIE1931_CURVE[value]);
 #endif
+    if (index >= 0 && index < DRIVER_LED_TOTAL) {
+        if (led_frame_valid && led_frame[index] == value) return;
+        led_frame[index] = value;
+    }
+    led_frame_changed = true;
     led_matrix_driver.set_value(index, value);
 }
 
@@ -174,10 +186,16 @@ void led_matrix_set_value_all(uint8_t value) {
         led_matrix_set_value(i, value);
 #else
 #    ifdef USE_CIE1931_CURVE
-    led_matrix_driver.set_value_all(pgm_read_byte(&CIE1931_CURVE[value]));
-#    else
-    led_matrix_driver.set_value_all(value);
+    value = pgm_read_byte(&CIE1931_CURVE[value]);
 #    endif
+    bool changed = !led_frame_valid;
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        changed |= led_frame[i] != value;
+        led_frame[i] = value;
+    }
+    if (!changed) return;
+    led_frame_changed = true;
+    led_matrix_driver.set_value_all(value);
 #endif
 }
 
@@ -344,8 +362,12 @@ static void led_task_flush(uint8_t effect) {
     led_last_effect = effect;
     led_last_enable = led_matrix_eeconfig.enable;
 
-    // update pwm buffers
-    led_matrix_update_pwm_buffers();
+    // update pwm buffers, unless the effect left every LED as it was
+    if (led_frame_changed) {
+        led_frame_changed = false;
+        led_frame_valid   = true;
+        led_matrix_update_pwm_buffers();
+    }
 
     // next task
     led_task_state = SYNCING;
@@ -415,8 +437,32 @@ __attribute__((weak)) void led_matrix_indicators_advanced_kb(uint8_t led_min, ui
 
 __attribute__((weak)) void led_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {}
 
+void led_matrix_force_next_frame(void) {
+    led_frame_valid   = false;
+    led_frame_changed = true;
+    // render the whole frame again from the start, even for LED_MATRIX_NONE
+    led_last_effect = UINT8_MAX;
+    led_task_state  = STARTING;
+}
+
+#ifdef LED_MATRIX_POLAR_ENABLED
+static void led_matrix_init_polar(void) {
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        int16_t dx           = g_led_config.point[i].x - k_led_matrix_center.x;
+        int16_t dy           = g_led_config.point[i].y - k_led_matrix_center.y;
+        g_led_polar[i].angle = atan2_8(dy, dx);
+        g_led_polar[i].dist  = sqrt16(dx * dx + dy * dy);
+    }
+}
+#endif // LED_MATRIX_POLAR_ENABLED
+
 void led_matrix_init(void) {
     led_matrix_driver.init();
+    led_matrix_force_next_frame();
+
+#ifdef LED_MATRIX_POLAR_ENABLED
+    led_matrix_init_polar();
+#endif // LED_MATRIX_POLAR_ENABLED
 
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
@@ -445,6 +491,10 @@ void led_matrix_init(void) {
 }
 
 void led_matrix_set_suspend_state(bool state) {
+    if (!state) {
+        // The LEDs may have been without power, and lost what they were showing
+        led_matrix_force_next_frame();
+    }
 #ifdef LED_DISABLE_WHEN_USB_SUSPENDED
     if (state && !suspend_state && is_keyboard_master()) { // only run if turning off, and only once
         led_task_render(0);                                // turn off all LEDs when suspending
@@ -128,6 +128,7 @@ void led_matrix_indicators_advanced_kb(uint8_t led_min, uint8_t led_max);
 void led_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max);
 
 void led_matrix_init(void);
+void led_matrix_force_next_frame(void); // resend the next frame even if unchanged, e.g. after the LEDs lost power
 
 void        led_matrix_set_suspend_state(bool state);
 bool        led_matrix_get_suspend_state(void);
@@ -199,3 +200,6 @@ extern last_hit_t g_last_hit_tracker;
 #ifdef LED_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_led_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
 #endif
+#ifdef LED_MATRIX_POLAR_ENABLED
+extern led_polar_t g_led_polar[DRIVER_LED_TOTAL];
+#endif
@@ -33,6 +33,10 @@
 #    define LED_MATRIX_KEYREACTIVE_ENABLED
 #endif
 
+#if defined(LED_MATRIX_POLAR_TABLE) || defined(ENABLE_LED_MATRIX_BAND_PINWHEEL) || defined(ENABLE_LED_MATRIX_BAND_SPIRAL) || defined(ENABLE_LED_MATRIX_CYCLE_OUT_IN)
+#    define LED_MATRIX_POLAR_ENABLED
+#endif
+
 // Last led hit
 #ifndef LED_HITS_TO_REMEMBER
 #    define LED_HITS_TO_REMEMBER 8
@@ -48,6 +52,14 @@ typedef struct PACKED {
 } last_hit_t;
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 
+#ifdef LED_MATRIX_POLAR_ENABLED
+// Where an led is around the center of the keyboard, worked out once at init
+typedef struct PACKED {
+    uint8_t angle; // atan2_8() of the offset from the center
+    uint8_t dist;  // distance from the center
+} led_polar_t;
+#endif // LED_MATRIX_POLAR_ENABLED
+
 typedef enum led_task_states { STARTING, RENDERING, FLUSHING, SYNCING } led_task_states;
 
 typedef uint8_t led_flags_t;
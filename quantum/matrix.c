@@ -336,6 +336,10 @@ uint8_t matrix_scan(void) {
     bool changed = memcmp(raw_matrix, curr_matrix, sizeof(curr_matrix)) != 0;
     if (changed) memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
 
+#ifdef LATENCY_TRACE_ENABLE
+    if (changed) latency_trace_mark(LATENCY_STAGE_RAW_MATRIX);
+#endif
+
 #ifdef SPLIT_KEYBOARD
     changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
 #else
@@ -168,6 +168,10 @@ __attribute__((weak)) void matrix_init(void) {
 __attribute__((weak)) uint8_t matrix_scan(void) {
     bool changed = matrix_scan_custom(raw_matrix);
 
+#ifdef LATENCY_TRACE_ENABLE
+    if (changed) latency_trace_mark(LATENCY_STAGE_RAW_MATRIX);
+#endif
+
 #ifdef SPLIT_KEYBOARD
     changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
 #else
@@ -0,0 +1,126 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "matrix_trace.h"
+#include "timer.h"
+#include "print.h"
+
+#ifndef MATRIX_TRACE_BUFFER_SIZE
+#    define MATRIX_TRACE_BUFFER_SIZE 256
+#endif
+
+// Bytes streamed per console line
+#ifndef MATRIX_TRACE_CONSOLE_CHUNK
+#    define MATRIX_TRACE_CONSOLE_CHUNK 16
+#endif
+
+#if (MATRIX_TRACE_BUFFER_SIZE & (MATRIX_TRACE_BUFFER_SIZE - 1)) != 0 || MATRIX_TRACE_BUFFER_SIZE > 32768
+#    error MATRIX_TRACE_BUFFER_SIZE must be a power of two, up to 32768
+#endif
+
+#if MATRIX_ROWS * MATRIX_COLS <= 128
+#    define TRACE_KEY_SIZE 1
+#else
+#    define TRACE_KEY_SIZE 2
+#endif
+
+// A time delta takes up to five bytes
+#define TRACE_EDGE_MAX_SIZE (5 + TRACE_KEY_SIZE)
+#define TRACE_INDEX(i) ((i) & (MATRIX_TRACE_BUFFER_SIZE - 1))
+
+static uint8_t  trace_buffer[MATRIX_TRACE_BUFFER_SIZE];
+static uint16_t trace_head    = 0; // next byte written
+static uint16_t trace_tail    = 0; // next byte read
+static uint32_t trace_time    = 0; // time of the last recorded edge
+static uint16_t trace_dropped = 0;
+#if defined(MATRIX_TRACE_CONSOLE) && defined(CONSOLE_ENABLE)
+static uint16_t trace_dropped_reported = 0;
+#endif
+
+void matrix_trace_record(uint8_t row, uint8_t col, bool pressed) {
+    if (MATRIX_TRACE_BUFFER_SIZE - (uint16_t)(trace_head - trace_tail) < TRACE_EDGE_MAX_SIZE) {
+        if (trace_dropped < UINT16_MAX) {
+            trace_dropped++;
+        }
+        return;
+    }
+
+    const uint32_t now   = timer_read32();
+    uint32_t       delta = TIMER_DIFF_32(now, trace_time);
+    trace_time           = now;
+
+    while (delta >= 0x80) {
+        trace_buffer[TRACE_INDEX(trace_head++)] = (delta & 0x7F) | 0x80;
+        delta >>= 7;
+    }
+    trace_buffer[TRACE_INDEX(trace_head++)] = delta;
+
+    const uint16_t key = row * MATRIX_COLS + col;
+#if TRACE_KEY_SIZE == 2
+    trace_buffer[TRACE_INDEX(trace_head++)] = (pressed ? 0x80 : 0) | (key >> 8);
+    trace_buffer[TRACE_INDEX(trace_head++)] = key & 0xFF;
+#else
+    trace_buffer[TRACE_INDEX(trace_head++)] = (pressed ? 0x80 : 0) | key;
+#endif
+}
+
+uint16_t matrix_trace_available(void) {
+    return trace_head - trace_tail;
+}
+
+uint16_t matrix_trace_get_dropped(void) {
+    return trace_dropped;
+}
+
+void matrix_trace_clear(void) {
+    trace_tail    = trace_head;
+    trace_time    = timer_read32();
+    trace_dropped = 0;
+#if defined(MATRIX_TRACE_CONSOLE) && defined(CONSOLE_ENABLE)
+    trace_dropped_reported = 0;
+#endif
+}
+
+uint16_t matrix_trace_read(uint8_t *data, uint16_t length) {
+    uint16_t size = 0;
+
+    while (trace_tail != trace_head) {
+        // Find the end of the edge at the tail: its time, then its key
+        uint16_t edge_size = 1;
+        while (trace_buffer[TRACE_INDEX(trace_tail + edge_size - 1)] & 0x80) {
+            edge_size++;
+        }
+        edge_size += TRACE_KEY_SIZE;
+
+        if (size + edge_size > length) {
+            break;
+        }
+        for (uint16_t i = 0; i < edge_size; i++) {
+            data[size++] = trace_buffer[TRACE_INDEX(trace_tail++)];
+        }
+    }
+
+    return size;
+}
+
+void matrix_trace_task(void) {
+#if defined(MATRIX_TRACE_CONSOLE) && defined(CONSOLE_ENABLE)
+    if (trace_dropped != trace_dropped_reported) {
+        xprintf("mtrace dropped %u\n", trace_dropped - trace_dropped_reported);
+        trace_dropped_reported = trace_dropped;
+    }
+
+    uint8_t        data[MATRIX_TRACE_CONSOLE_CHUNK];
+    const uint16_t size = matrix_trace_read(data, sizeof(data));
+    if (size == 0) {
+        return;
+    }
+
+    // Rows and columns on every line, so the host can decode any part of the log
+    xprintf("mtrace %u %u ", MATRIX_ROWS, MATRIX_COLS);
+    for (uint16_t i = 0; i < size; i++) {
+        xprintf("%02X", data[i]);
+    }
+    xprintf("\n");
+#endif
+}
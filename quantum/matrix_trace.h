@@ -0,0 +1,49 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/** \file
+ *
+ * Records the switch matrix edges of real typing into a small RAM buffer, to
+ * be read out by a host tool and replayed through the key simulator.
+ *
+ * Each edge is stored as the time in milliseconds since the previous edge,
+ * LEB128 encoded (one byte for gaps below 128ms), followed by the key: a single
+ * byte `pressed << 7 | (row * MATRIX_COLS + col)` for matrices of up to 128
+ * keys, or two bytes big endian with the pressed flag in bit 15 otherwise.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** \brief Append an edge to the buffer, called from switch_events()
+ *
+ * Edges that do not fit are dropped and counted; the next recorded edge still
+ * carries the time since the last one that was kept.
+ */
+void matrix_trace_record(uint8_t row, uint8_t col, bool pressed);
+
+/** \brief Stream the buffer to the console, if MATRIX_TRACE_CONSOLE is defined
+ */
+void matrix_trace_task(void);
+
+/** \brief Discard all buffered edges, and time the next one from now
+ */
+void matrix_trace_clear(void);
+
+/** \brief Number of bytes currently buffered
+ */
+uint16_t matrix_trace_available(void);
+
+/** \brief Number of edges dropped because the buffer was full, since the last clear
+ */
+uint16_t matrix_trace_get_dropped(void);
+
+/** \brief Move buffered edges into data, oldest first
+ *
+ * Only whole edges are copied, so every chunk read can be decoded on its own.
+ *
+ * \return the number of bytes written to data
+ */
+uint16_t matrix_trace_read(uint8_t *data, uint16_t length);
@@ -77,6 +77,187 @@ static report_mouse_t local_mouse_report = {};
 
 extern const pointing_device_driver_t pointing_device_driver;
 
+/**
+ * @brief clamps int16_t to int8_t
+ *
+ * @param[in] int16_t value
+ * @return int8_t clamped value
+ */
+static inline int8_t pointing_device_hv_clamp(int16_t value) {
+    if (value < INT8_MIN) {
+        return INT8_MIN;
+    } else if (value > INT8_MAX) {
+        return INT8_MAX;
+    } else {
+        return value;
+    }
+}
+
+/**
+ * @brief clamps int16_t to int8_t
+ *
+ * @param[in] clamp_range_t value
+ * @return mouse_xy_report_t clamped value
+ */
+static inline mouse_xy_report_t pointing_device_xy_clamp(clamp_range_t value) {
+    if (value < XY_REPORT_MIN) {
+        return XY_REPORT_MIN;
+    } else if (value > XY_REPORT_MAX) {
+        return XY_REPORT_MAX;
+    } else {
+        return value;
+    }
+}
+
+#if defined(SPLIT_POINTING_ENABLE) && defined(POINTING_DEVICE_COMBINED)
+static clamp_range_t combined_carry_x = 0;
+static clamp_range_t combined_carry_y = 0;
+static int16_t       combined_carry_v = 0;
+static int16_t       combined_carry_h = 0;
+
+/**
+ * @brief clamps to mouse_xy_report_t, carrying what does not fit into the next report
+ *
+ * The carry is limited to a single report's worth of motion so a sensor that keeps saturating cannot build up an unbounded backlog.
+ *
+ * @param[in] value clamp_range_t motion for this report
+ * @param[in,out] carry clamp_range_t remainder from previous reports
+ * @return mouse_xy_report_t clamped value
+ */
+static mouse_xy_report_t pointing_device_xy_carry(clamp_range_t value, clamp_range_t *carry) {
+    mouse_xy_report_t clamped = pointing_device_xy_clamp(value + *carry);
+    *carry                    = pointing_device_xy_clamp(value + *carry - clamped);
+    return clamped;
+}
+
+/**
+ * @brief clamps to int8_t, carrying what does not fit into the next report
+ *
+ * @param[in] value int16_t scroll for this report
+ * @param[in,out] carry int16_t remainder from previous reports
+ * @return int8_t clamped value
+ */
+static int8_t pointing_device_hv_carry(int16_t value, int16_t *carry) {
+    int8_t clamped = pointing_device_hv_clamp(value + *carry);
+    *carry         = pointing_device_hv_clamp(value + *carry - clamped);
+    return clamped;
+}
+#endif
+
+#ifdef POINTING_DEVICE_MOTION_PIN
+#    if defined(PROTOCOL_CHIBIOS)
+#        include <ch.h>
+#    endif
+
+#    ifndef POINTING_DEVICE_MOTION_CARRY_MAX
+#        define POINTING_DEVICE_MOTION_CARRY_MAX (4 * (int32_t)XY_REPORT_MAX)
+#    endif
+
+typedef struct {
+    int32_t x;
+    int32_t y;
+    int16_t v;
+    int16_t h;
+} motion_accumulator_t;
+
+static motion_accumulator_t           motion_accumulator = {};
+static pointing_device_motion_stats_t motion_stats       = {};
+static pointing_device_motion_stats_t motion_window      = {};
+static uint16_t                       motion_window_start;
+
+/**
+ * @brief Limits accumulated motion, counting what is thrown away
+ *
+ * @param[in] value int32_t accumulated motion
+ * @return int32_t value within +/- POINTING_DEVICE_MOTION_CARRY_MAX
+ */
+static int32_t pointing_device_motion_limit(int32_t value) {
+    if (value > POINTING_DEVICE_MOTION_CARRY_MAX) {
+        motion_window.dropped += value - POINTING_DEVICE_MOTION_CARRY_MAX;
+        return POINTING_DEVICE_MOTION_CARRY_MAX;
+    } else if (value < -POINTING_DEVICE_MOTION_CARRY_MAX) {
+        motion_window.dropped += -POINTING_DEVICE_MOTION_CARRY_MAX - value;
+        return -POINTING_DEVICE_MOTION_CARRY_MAX;
+    }
+    return value;
+}
+
+/**
+ * @brief Reads the sensor if it signals motion and accumulates its deltas
+ *
+ * Runs on every keyboard loop regardless of POINTING_DEVICE_TASK_THROTTLE_MS, so motion is collected at the rate the sensor produces it.
+ */
+static void pointing_device_motion_read(void) {
+    if (readPin(POINTING_DEVICE_MOTION_PIN)) {
+        return;
+    }
+
+    report_mouse_t report = local_mouse_report;
+    report.x              = 0;
+    report.y              = 0;
+    report.v              = 0;
+    report.h              = 0;
+
+#    if defined(PROTOCOL_CHIBIOS)
+    systime_t start = chVTGetSystemTimeX();
+    report          = pointing_device_driver.get_report(report);
+    motion_window.read_us += TIME_I2US(chTimeDiffX(start, chVTGetSystemTimeX()));
+#    else
+    report = pointing_device_driver.get_report(report);
+#    endif
+    motion_window.reads++;
+
+    motion_accumulator.x       = pointing_device_motion_limit(motion_accumulator.x + report.x);
+    motion_accumulator.y       = pointing_device_motion_limit(motion_accumulator.y + report.y);
+    motion_accumulator.v       = pointing_device_hv_clamp(motion_accumulator.v + report.v);
+    motion_accumulator.h       = pointing_device_hv_clamp(motion_accumulator.h + report.h);
+    local_mouse_report.buttons = report.buttons;
+}
+
+/**
+ * @brief Moves accumulated motion into a report
+ *
+ * Whatever does not fit into the report is carried over to the next one instead of being clamped away.
+ *
+ * @param[in] mouse_report report_mouse_t
+ * @return report_mouse_t with accumulated motion
+ */
+static report_mouse_t pointing_device_motion_take(report_mouse_t mouse_report) {
+    mouse_report.x = pointing_device_xy_clamp(motion_accumulator.x);
+    mouse_report.y = pointing_device_xy_clamp(motion_accumulator.y);
+    mouse_report.v = motion_accumulator.v;
+    mouse_report.h = motion_accumulator.h;
+    motion_accumulator.x -= mouse_report.x;
+    motion_accumulator.y -= mouse_report.y;
+    motion_accumulator.v = 0;
+    motion_accumulator.h = 0;
+
+    if (mouse_report.x || mouse_report.y || mouse_report.v || mouse_report.h) {
+        motion_window.reports++;
+    }
+
+    if (timer_elapsed(motion_window_start) >= 1000) {
+        motion_stats        = motion_window;
+        motion_window       = (pointing_device_motion_stats_t){};
+        motion_window_start = timer_read();
+    }
+    return mouse_report;
+}
+
+/**
+ * @brief Gets motion pipeline statistics
+ *
+ * Returns the number of sensor reads, non-empty reports, motion counts dropped and microseconds spent reading the sensor (ChibiOS only) over the last full second.
+ *
+ * NOTE : Only available when using POINTING_DEVICE_MOTION_PIN
+ *
+ * @return pointing_device_motion_stats_t
+ */
+pointing_device_motion_stats_t pointing_device_motion_get_stats(void) {
+    return motion_stats;
+}
+#endif
+
 /**
  * @brief Keyboard level code pointing device initialisation
  *
@@ -225,6 +406,13 @@ __attribute__((weak)) void pointing_device_task(void) {
     };
 #endif
 
+#ifdef POINTING_DEVICE_MOTION_PIN
+#    if defined(SPLIT_POINTING_ENABLE)
+#        error POINTING_DEVICE_MOTION_PIN not supported when sharing the pointing device report between sides.
+#    endif
+    pointing_device_motion_read();
+#endif
+
 #if (POINTING_DEVICE_TASK_THROTTLE_MS > 0)
     static uint32_t last_exec = 0;
     if (timer_elapsed32(last_exec) < POINTING_DEVICE_TASK_THROTTLE_MS) {
@@ -234,14 +422,9 @@ __attribute__((weak)) void pointing_device_task(void) {
 #endif
 
     // Gather report info
-#ifdef POINTING_DEVICE_MOTION_PIN
-#    if defined(SPLIT_POINTING_ENABLE)
-#        error POINTING_DEVICE_MOTION_PIN not supported when sharing the pointing device report between sides.
-#    endif
-    if (!readPin(POINTING_DEVICE_MOTION_PIN))
-#endif
-
-#if defined(SPLIT_POINTING_ENABLE)
+#if defined(POINTING_DEVICE_MOTION_PIN)
+    local_mouse_report = pointing_device_motion_take(local_mouse_report);
+#elif defined(SPLIT_POINTING_ENABLE)
 #    if defined(POINTING_DEVICE_COMBINED)
         static uint8_t old_buttons = 0;
     local_mouse_report.buttons = old_buttons;
@@ -269,6 +452,9 @@ __attribute__((weak)) void pointing_device_task(void) {
 #else
     local_mouse_report = pointing_device_adjust_by_defines(local_mouse_report);
     local_mouse_report = pointing_device_task_kb(local_mouse_report);
+#endif
+#ifdef POINTING_DEVICE_ACCEL_ENABLE
+    local_mouse_report = pointing_device_accel_apply(local_mouse_report);
 #endif
     // combine with mouse report to ensure that the combined is sent correctly
 #ifdef MOUSEKEY_ENABLE
@@ -311,6 +497,35 @@ uint16_t pointing_device_get_cpi(void) {
 #endif
 }
 
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+/**
+ * @brief Gets the number of vertical wheel counts per scroll detent
+ *
+ * Hosts that enable high-resolution scrolling divide the v report value by this, so scroll produced by drivers or user code should be scaled up by it.
+ * Returns 1 until the host has enabled the resolution multiplier, and again after a USB reset.
+ *
+ * NOTE : Only available when using POINTING_DEVICE_HIRES_SCROLL_ENABLE
+ *
+ * @return multiplier as uint16_t
+ */
+uint16_t pointing_device_get_hires_scroll_resolution(void) {
+    return (host_mouse_resolution_multiplier() & MOUSE_RESOLUTION_MULTIPLIER_V) ? POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER : 1;
+}
+
+/**
+ * @brief Gets the number of horizontal wheel counts per scroll detent
+ *
+ * Same as pointing_device_get_hires_scroll_resolution, for the h report value.
+ *
+ * NOTE : Only available when using POINTING_DEVICE_HIRES_SCROLL_ENABLE
+ *
+ * @return multiplier as uint16_t
+ */
+uint16_t pointing_device_get_hires_hscroll_resolution(void) {
+    return (host_mouse_resolution_multiplier() & MOUSE_RESOLUTION_MULTIPLIER_H) ? POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER : 1;
+}
+#endif
+
 /**
  * @brief Set pointing device CPI if supported
  *
@@ -350,41 +565,11 @@ void pointing_device_set_cpi_on_side(bool left, uint16_t cpi) {
     }
 }
 
-/**
- * @brief clamps int16_t to int8_t
- *
- * @param[in] int16_t value
- * @return int8_t clamped value
- */
-static inline int8_t pointing_device_hv_clamp(int16_t value) {
-    if (value < INT8_MIN) {
-        return INT8_MIN;
-    } else if (value > INT8_MAX) {
-        return INT8_MAX;
-    } else {
-        return value;
-    }
-}
-
-/**
- * @brief clamps int16_t to int8_t
- *
- * @param[in] clamp_range_t value
- * @return mouse_xy_report_t clamped value
- */
-static inline mouse_xy_report_t pointing_device_xy_clamp(clamp_range_t value) {
-    if (value < XY_REPORT_MIN) {
-        return XY_REPORT_MIN;
-    } else if (value > XY_REPORT_MAX) {
-        return XY_REPORT_MAX;
-    } else {
-        return value;
-    }
-}
 /**
  * @brief combines 2 mouse reports and returns 2
  *
- * Combines 2 report_mouse_t structs, clamping movement values to int8_t and ignores report_id then returns the resulting report_mouse_t struct.
+ * Combines 2 report_mouse_t structs, clamping movement values to the report range and ignores report_id then returns the resulting report_mouse_t struct.
+ * Motion that does not fit is carried over into the next combined report rather than discarded.
  *
  * NOTE: Only available when using SPLIT_POINTING_ENABLE and POINTING_DEVICE_COMBINED
  *
@@ -393,10 +578,10 @@ static inline mouse_xy_report_t pointing_device_xy_clamp(clamp_range_t value) {
  * @return combined report_mouse_t of left_report and right_report
  */
 report_mouse_t pointing_device_combine_reports(report_mouse_t left_report, report_mouse_t right_report) {
-    left_report.x = pointing_device_xy_clamp((clamp_range_t)left_report.x + right_report.x);
-    left_report.y = pointing_device_xy_clamp((clamp_range_t)left_report.y + right_report.y);
-    left_report.h = pointing_device_hv_clamp((int16_t)left_report.h + right_report.h);
-    left_report.v = pointing_device_hv_clamp((int16_t)left_report.v + right_report.v);
+    left_report.x = pointing_device_xy_carry((clamp_range_t)left_report.x + right_report.x, &combined_carry_x);
+    left_report.y = pointing_device_xy_carry((clamp_range_t)left_report.y + right_report.y, &combined_carry_y);
+    left_report.h = pointing_device_hv_carry((int16_t)left_report.h + right_report.h, &combined_carry_h);
+    left_report.v = pointing_device_hv_carry((int16_t)left_report.v + right_report.v, &combined_carry_v);
     left_report.buttons |= right_report.buttons;
     return left_report;
 }
@@ -20,6 +20,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <stdint.h>
 #include "host.h"
 #include "report.h"
+#ifdef POINTING_DEVICE_ACCEL_ENABLE
+#    include "pointing_device_accel.h"
+#endif
 
 #if defined(POINTING_DEVICE_DRIVER_adns5050)
 #    include "drivers/sensors/adns5050.h"
@@ -101,6 +104,25 @@ report_mouse_t pointing_device_task_user(report_mouse_t mouse_report);
 uint8_t        pointing_device_handle_buttons(uint8_t buttons, bool pressed, pointing_device_buttons_t button);
 report_mouse_t pointing_device_adjust_by_defines(report_mouse_t mouse_report);
 
+#if defined(POINTING_DEVICE_HIRES_SCROLL_ENABLE)
+uint16_t pointing_device_get_hires_scroll_resolution(void);
+uint16_t pointing_device_get_hires_hscroll_resolution(void);
+#endif
+
+#if defined(POINTING_DEVICE_MOTION_PIN)
+typedef struct {
+    uint16_t reads;
+    uint16_t reports;
+    uint32_t dropped;
+    uint32_t read_us;
+} pointing_device_motion_stats_t;
+
+pointing_device_motion_stats_t pointing_device_motion_get_stats(void);
+#    if !defined(POINTING_DEVICE_TASK_THROTTLE_MS)
+#        define POINTING_DEVICE_TASK_THROTTLE_MS 1
+#    endif
+#endif
+
 #if defined(SPLIT_POINTING_ENABLE)
 void     pointing_device_set_shared_report(report_mouse_t report);
 uint16_t pointing_device_get_shared_cpi(void);
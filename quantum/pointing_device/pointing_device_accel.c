@@ -0,0 +1,193 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "pointing_device_accel.h"
+#include "pointing_device.h"
+
+#ifdef POINTING_DEVICE_ACCEL_ENABLE
+
+#    ifndef POINTING_DEVICE_ACCEL_CURVE
+#        define POINTING_DEVICE_ACCEL_CURVE \
+            { 16, 16, 20, 24, 28, 32, 36, 40 }
+#    endif
+
+#    ifndef POINTING_DEVICE_ACCEL_SPEED_SHIFT
+#        define POINTING_DEVICE_ACCEL_SPEED_SHIFT 2
+#    endif
+
+#    ifndef POINTING_DEVICE_ACCEL_SMOOTHING
+#        define POINTING_DEVICE_ACCEL_SMOOTHING 63
+#    endif
+
+#    ifndef POINTING_DEVICE_ACCEL_SMOOTHING_SPEED
+#        define POINTING_DEVICE_ACCEL_SMOOTHING_SPEED 32
+#    endif
+
+// Smoothed motion is kept with 4 fractional bits, unsent output with 8
+#    define ACCEL_FILTER_ONE 16
+#    define ACCEL_FILTER_SHIFT 4
+#    define ACCEL_OUTPUT_ONE 256
+#    define ACCEL_OUTPUT_SHIFT 8
+// Keeps pending * weight within int32_t
+#    define ACCEL_PENDING_MAX ((int32_t)8 * XY_REPORT_MAX * ACCEL_FILTER_ONE)
+
+typedef struct {
+    int32_t pending;
+    int32_t remainder;
+} accel_axis_t;
+
+static pointing_device_accel_config_t accel_config = {
+    .gain            = POINTING_DEVICE_ACCEL_CURVE,
+    .speed_shift     = POINTING_DEVICE_ACCEL_SPEED_SHIFT,
+    .smoothing       = POINTING_DEVICE_ACCEL_SMOOTHING,
+    .smoothing_speed = POINTING_DEVICE_ACCEL_SMOOTHING_SPEED,
+};
+static accel_axis_t accel_x = {};
+static accel_axis_t accel_y = {};
+
+/**
+ * @brief Approximates the length of a motion vector without a square root
+ *
+ * Uses max + 3/8 min, which stays within 7% of the true length.
+ *
+ * @param[in] x int32_t
+ * @param[in] y int32_t
+ * @return uint32_t approximate length
+ */
+static uint32_t accel_magnitude(int32_t x, int32_t y) {
+    if (x < 0) x = -x;
+    if (y < 0) y = -y;
+    return x > y ? x + ((3 * y) >> 3) : y + ((3 * x) >> 3);
+}
+
+/**
+ * @brief Looks up the gain for a speed, interpolating between curve points
+ *
+ * @param[in] speed uint32_t counts per report
+ * @return uint16_t gain with 8 fractional bits
+ */
+static uint16_t accel_gain(uint32_t speed) {
+    uint32_t index = speed >> accel_config.speed_shift;
+    if (index >= POINTING_DEVICE_ACCEL_CURVE_POINTS - 1) {
+        return accel_config.gain[POINTING_DEVICE_ACCEL_CURVE_POINTS - 1] * ACCEL_FILTER_ONE;
+    }
+
+    int32_t fraction = speed - (index << accel_config.speed_shift);
+    int32_t delta    = ((int32_t)accel_config.gain[index + 1] - accel_config.gain[index]) * ACCEL_FILTER_ONE;
+    return accel_config.gain[index] * ACCEL_FILTER_ONE + ((delta * fraction) >> accel_config.speed_shift);
+}
+
+/**
+ * @brief Releases part of the motion pending on an axis
+ *
+ * Releasing a fixed share of what is pending each report is an exponential moving average of the input, but only ever moves
+ * motion between reports so none is lost to rounding. At least one fractional step is released so the axis always settles.
+ *
+ * @param[in] axis accel_axis_t
+ * @param[in] value int32_t motion in this report
+ * @param[in] weight uint16_t share to release, out of 256
+ * @return int32_t smoothed motion with 4 fractional bits
+ */
+static int32_t accel_filter(accel_axis_t *axis, int32_t value, uint16_t weight) {
+    axis->pending += value * ACCEL_FILTER_ONE;
+    if (axis->pending > ACCEL_PENDING_MAX) {
+        axis->pending = ACCEL_PENDING_MAX;
+    } else if (axis->pending < -ACCEL_PENDING_MAX) {
+        axis->pending = -ACCEL_PENDING_MAX;
+    }
+
+    int32_t step = (axis->pending * weight) >> 8;
+    if (step == 0 && axis->pending != 0) {
+        step = axis->pending > 0 ? 1 : -1;
+    }
+    axis->pending -= step;
+    return step;
+}
+
+/**
+ * @brief Applies the gain to the smoothed motion of an axis
+ *
+ * Fractions of a count and anything beyond the report range are carried over to the next report.
+ *
+ * @param[in] axis accel_axis_t
+ * @param[in] motion int32_t smoothed motion with 4 fractional bits
+ * @param[in] gain uint16_t with 8 fractional bits
+ * @return mouse_xy_report_t motion to report
+ */
+static mouse_xy_report_t accel_output(accel_axis_t *axis, int32_t motion, uint16_t gain) {
+    int32_t total  = ((motion * gain) >> ACCEL_FILTER_SHIFT) + axis->remainder;
+    int32_t report = total >> ACCEL_OUTPUT_SHIFT;
+    if (report > XY_REPORT_MAX) {
+        report = XY_REPORT_MAX;
+    } else if (report < XY_REPORT_MIN) {
+        report = XY_REPORT_MIN;
+    }
+
+    axis->remainder = total - report * ACCEL_OUTPUT_ONE;
+    if (axis->remainder > (int32_t)XY_REPORT_MAX * ACCEL_OUTPUT_ONE) {
+        axis->remainder = (int32_t)XY_REPORT_MAX * ACCEL_OUTPUT_ONE;
+    } else if (axis->remainder < (int32_t)XY_REPORT_MIN * ACCEL_OUTPUT_ONE) {
+        axis->remainder = (int32_t)XY_REPORT_MIN * ACCEL_OUTPUT_ONE;
+    }
+    return report;
+}
+
+/**
+ * @brief Gets the current acceleration and smoothing configuration
+ *
+ * @param[out] config pointing_device_accel_config_t
+ */
+void pointing_device_accel_get_config(pointing_device_accel_config_t *config) {
+    *config = accel_config;
+}
+
+/**
+ * @brief Replaces the acceleration and smoothing configuration
+ *
+ * Clears any motion still held by the filter, so this is safe to call while the pointer is moving.
+ *
+ * @param[in] config pointing_device_accel_config_t
+ */
+void pointing_device_accel_set_config(const pointing_device_accel_config_t *config) {
+    accel_config = *config;
+    if (accel_config.speed_shift > 15) {
+        accel_config.speed_shift = 15;
+    }
+    pointing_device_accel_reset();
+}
+
+/**
+ * @brief Clears motion held by the filter and fractional counts not yet reported
+ */
+void pointing_device_accel_reset(void) {
+    accel_x = (accel_axis_t){};
+    accel_y = (accel_axis_t){};
+}
+
+/**
+ * @brief Smooths and accelerates the X/Y motion of a mouse report
+ *
+ * Uses integer math only, so it is cheap enough to run on every report on AVR and Cortex-M0.
+ *
+ * @param[in] mouse_report report_mouse_t
+ * @return report_mouse_t with adjusted motion
+ */
+report_mouse_t pointing_device_accel_apply(report_mouse_t mouse_report) {
+    uint16_t weight = 256;
+    if (accel_config.smoothing < UINT8_MAX) {
+        uint32_t adaptive = accel_config.smoothing + 1 + accel_config.smoothing_speed * accel_magnitude(mouse_report.x, mouse_report.y);
+        if (adaptive < weight) {
+            weight = adaptive;
+        }
+    }
+
+    int32_t x = accel_filter(&accel_x, mouse_report.x, weight);
+    int32_t y = accel_filter(&accel_y, mouse_report.y, weight);
+
+    uint16_t gain  = accel_gain(accel_magnitude(x, y) >> ACCEL_FILTER_SHIFT);
+    mouse_report.x = accel_output(&accel_x, x, gain);
+    mouse_report.y = accel_output(&accel_y, y, gain);
+    return mouse_report;
+}
+
+#endif
@@ -0,0 +1,35 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include "report.h"
+
+#ifndef POINTING_DEVICE_ACCEL_CURVE_POINTS
+#    define POINTING_DEVICE_ACCEL_CURVE_POINTS 8
+#endif
+
+/**
+ * @brief Runtime configuration of the acceleration and smoothing stage
+ *
+ * Gains are fixed point with four fractional bits (16 = 1.0x) and apply at
+ * speeds of 0, 1 << speed_shift, 2 << speed_shift, ... counts per report,
+ * linearly interpolated in between and held beyond the last point.
+ *
+ * Smoothing blends each report into the previous ones with a weight of
+ * (smoothing + 1) / 256, raised by smoothing_speed / 256 for every count per
+ * report the pointer is moving, so slow precise movement is filtered while
+ * fast movement passes through without lag. A smoothing of 255 disables it.
+ */
+typedef struct {
+    uint8_t gain[POINTING_DEVICE_ACCEL_CURVE_POINTS];
+    uint8_t speed_shift;
+    uint8_t smoothing;
+    uint8_t smoothing_speed;
+} pointing_device_accel_config_t;
+
+void           pointing_device_accel_get_config(pointing_device_accel_config_t *config);
+void           pointing_device_accel_set_config(const pointing_device_accel_config_t *config);
+void           pointing_device_accel_reset(void);
+report_mouse_t pointing_device_accel_apply(report_mouse_t mouse_report);
@@ -0,0 +1,164 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <iostream>
+
+extern "C" {
+#include "pointing_device_accel.h"
+}
+
+class PointingDeviceAccel : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        pointing_device_accel_get_config(&defaults);
+        pointing_device_accel_reset();
+    }
+
+    void TearDown() override {
+        pointing_device_accel_set_config(&defaults);
+    }
+
+    void set_flat_curve(uint8_t gain, uint8_t smoothing = UINT8_MAX) {
+        pointing_device_accel_config_t config = {};
+        for (int i = 0; i < POINTING_DEVICE_ACCEL_CURVE_POINTS; i++) {
+            config.gain[i] = gain;
+        }
+        config.speed_shift     = 2;
+        config.smoothing       = smoothing;
+        config.smoothing_speed = 0;
+        pointing_device_accel_set_config(&config);
+    }
+
+    report_mouse_t move(int16_t x, int16_t y) {
+        report_mouse_t report = {};
+        report.x              = x;
+        report.y              = y;
+        return pointing_device_accel_apply(report);
+    }
+
+    // Feeds empty reports until the filter has emptied, returning the motion it released
+    int32_t drain_x(void) {
+        int32_t total = 0;
+        for (int i = 0; i < 1000; i++) {
+            total += move(0, 0).x;
+        }
+        return total;
+    }
+
+    pointing_device_accel_config_t defaults;
+};
+
+TEST_F(PointingDeviceAccel, UnityGainWithoutSmoothingPassesThrough) {
+    set_flat_curve(16);
+
+    for (int16_t x = -20; x <= 20; x++) {
+        report_mouse_t report = move(x, -x);
+        EXPECT_EQ(report.x, x);
+        EXPECT_EQ(report.y, -x);
+    }
+}
+
+TEST_F(PointingDeviceAccel, FastMotionIsAccelerated) {
+    pointing_device_accel_config_t config;
+    pointing_device_accel_get_config(&config);
+    config.smoothing = UINT8_MAX;
+    pointing_device_accel_set_config(&config);
+
+    // Slow motion stays at 1x on the default curve
+    EXPECT_EQ(move(2, 0).x, 2);
+    // Beyond the last curve point the default gain is 2.5x
+    EXPECT_EQ(move(40, 0).x, 100);
+}
+
+TEST_F(PointingDeviceAccel, GainIsInterpolatedBetweenCurvePoints) {
+    pointing_device_accel_config_t config = {};
+    config.gain[0]     = 16;
+    config.gain[1]     = 32;
+    config.gain[2]     = 32;
+    config.speed_shift = 2;
+    config.smoothing   = UINT8_MAX;
+    pointing_device_accel_set_config(&config);
+
+    // Halfway between 1x at 0 and 2x at 4 counts per report
+    EXPECT_EQ(move(2, 0).x, 3);
+    EXPECT_EQ(move(4, 0).x, 8);
+}
+
+TEST_F(PointingDeviceAccel, FractionalCountsAreCarried) {
+    set_flat_curve(24);
+
+    int32_t total = 0;
+    for (int i = 0; i < 10; i++) {
+        report_mouse_t report = move(1, 0);
+        EXPECT_GE(report.x, 1);
+        EXPECT_LE(report.x, 2);
+        total += report.x;
+    }
+    EXPECT_EQ(total, 15);
+}
+
+TEST_F(PointingDeviceAccel, MotionBeyondReportRangeIsCarried) {
+    set_flat_curve(64);
+
+    EXPECT_EQ(move(50, 0).x, INT8_MAX);
+    EXPECT_EQ(drain_x(), 200 - INT8_MAX);
+}
+
+TEST_F(PointingDeviceAccel, SmoothingReducesJitterWithoutLosingMotion) {
+    set_flat_curve(16, 31);
+
+    int32_t total = 0;
+    int16_t peak  = 0;
+    for (int i = 0; i < 20; i++) {
+        report_mouse_t report = move(i % 2 ? 3 : -2, 0);
+        total += report.x;
+        peak = std::max<int16_t>(peak, abs(report.x));
+    }
+    EXPECT_LT(peak, 3);
+
+    total += drain_x();
+    EXPECT_EQ(total, 10);
+}
+
+TEST_F(PointingDeviceAccel, SmoothingFollowsFastMotion) {
+    pointing_device_accel_config_t config;
+    pointing_device_accel_get_config(&config);
+    for (int i = 0; i < POINTING_DEVICE_ACCEL_CURVE_POINTS; i++) {
+        config.gain[i] = 16;
+    }
+    pointing_device_accel_set_config(&config);
+
+    // Fast enough for the default smoothing to get out of the way entirely
+    EXPECT_EQ(move(0, 10).y, 10);
+    EXPECT_EQ(move(0, -10).y, -10);
+}
+
+TEST_F(PointingDeviceAccel, CyclesPerReportBenchmark) {
+    const int iterations = 100000;
+    int32_t   sink       = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        report_mouse_t report = move((i % 31) - 15, (i % 17) - 8);
+        sink += report.x + report.y;
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "pointing_device_accel_apply: " << elapsed / iterations << " ns per report (" << sink << ")" << std::endl;
+    RecordProperty("ns_per_report", (int)(elapsed / iterations));
+}
@@ -0,0 +1,9 @@
+pointing_device_accel_DEFS := -DPOINTING_DEVICE_ACCEL_ENABLE
+
+pointing_device_accel_SRC := \
+	$(QUANTUM_PATH)/pointing_device/tests/pointing_device_accel_tests.cpp \
+	$(QUANTUM_PATH)/pointing_device/pointing_device_accel.c
+
+pointing_device_accel_INC := \
+	$(QUANTUM_PATH)/pointing_device \
+	$(TMK_PATH)/protocol
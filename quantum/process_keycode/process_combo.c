@@ -242,6 +242,7 @@ static inline void dump_key_buffer(void) {
         // only delay once and for a non-tapping key
         if (!delay_done && !is_tap_record(record)) {
             delay_done = true;
+            flush_keyboard_report();
             wait_ms(TAP_CODE_DELAY);
         }
 #endif
@@ -45,6 +45,50 @@ __attribute__((weak)) void dynamic_macro_record_end_user(int8_t direction) {
     dynamic_macro_led_blink();
 }
 
+/* Maximum number of macros playing at the same time, i.e. one macro
+ * replaying the other one. Deeper nesting is ignored, which also stops
+ * recursive macros from running forever.
+ */
+#define DYNAMIC_MACRO_MAX_DEPTH 2
+
+/* Recorded delays below this are stored exactly, longer ones in steps of
+ * DYNAMIC_MACRO_DELAY_STEP ms, up to a little over two seconds.
+ */
+#define DYNAMIC_MACRO_DELAY_EXACT 128
+#define DYNAMIC_MACRO_DELAY_STEP 16
+
+typedef struct {
+    dynamic_macro_event_t *begin;
+    dynamic_macro_event_t *pointer;
+    dynamic_macro_event_t *end;
+    int8_t                 direction;
+    layer_state_t          saved_layer_state;
+} dynamic_macro_player_t;
+
+static dynamic_macro_player_t dynamic_macro_players[DYNAMIC_MACRO_MAX_DEPTH];
+static uint8_t                dynamic_macro_depth     = 0;
+static bool                   dynamic_macro_replaying = false;
+static uint16_t               dynamic_macro_timer;
+static uint16_t               dynamic_macro_last_event;
+static uint8_t                dynamic_macro_speed = 100;
+
+static uint8_t dynamic_macro_encode_delay(uint16_t delay) {
+    if (delay < DYNAMIC_MACRO_DELAY_EXACT) {
+        return delay;
+    }
+    delay = (delay - DYNAMIC_MACRO_DELAY_EXACT) / DYNAMIC_MACRO_DELAY_STEP;
+    return DYNAMIC_MACRO_DELAY_EXACT + (delay < UINT8_MAX - DYNAMIC_MACRO_DELAY_EXACT ? delay : UINT8_MAX - DYNAMIC_MACRO_DELAY_EXACT);
+}
+
+#ifdef DYNAMIC_MACRO_REPLAY_TIMING
+static uint16_t dynamic_macro_decode_delay(uint8_t delay) {
+    if (delay < DYNAMIC_MACRO_DELAY_EXACT) {
+        return delay;
+    }
+    return DYNAMIC_MACRO_DELAY_EXACT + (delay - DYNAMIC_MACRO_DELAY_EXACT) * DYNAMIC_MACRO_DELAY_STEP;
+}
+#endif
+
 /* Convenience macros used for retrieving the debug info. All of them
  * need a `direction` variable accessible at the call site.
  */
@@ -58,9 +102,10 @@ __attribute__((weak)) void dynamic_macro_record_end_user(int8_t direction) {
  * @param[out] macro_pointer The new macro buffer iterator.
  * @param[in]  macro_buffer  The macro buffer used to initialize macro_pointer.
  */
-void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_buffer) {
+void dynamic_macro_record_start(dynamic_macro_event_t **macro_pointer, dynamic_macro_event_t *macro_buffer) {
     dprintln("dynamic macro recording: started");
 
+    dynamic_macro_cancel();
     dynamic_macro_record_start_user();
 
     clear_keyboard();
@@ -71,31 +116,124 @@ void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_
 /**
  * Play the dynamic macro.
  *
+ * The playback itself happens in dynamic_macro_task(), a key at a time,
+ * so the keyboard keeps working while the macro plays.
+ *
  * @param macro_buffer[in] The beginning of the macro buffer being played.
  * @param macro_end[in]    The element after the last macro buffer element.
  * @param direction[in]    Either +1 or -1, which way to iterate the buffer.
  */
-void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_t direction) {
+void dynamic_macro_play(dynamic_macro_event_t *macro_buffer, dynamic_macro_event_t *macro_end, int8_t direction) {
+    if (dynamic_macro_depth == DYNAMIC_MACRO_MAX_DEPTH) {
+        dprintln("dynamic macro: ignoring playback nested too deeply");
+        return;
+    }
+
     dprintf("dynamic macro: slot %d playback\n", DYNAMIC_MACRO_CURRENT_SLOT());
 
-    layer_state_t saved_layer_state = layer_state;
+    dynamic_macro_player_t *player = &dynamic_macro_players[dynamic_macro_depth++];
+    player->begin                  = macro_buffer;
+    player->pointer                = macro_buffer;
+    player->end                    = macro_end;
+    player->direction              = direction;
+    player->saved_layer_state      = layer_state;
 
     clear_keyboard();
     layer_clear();
 
-    while (macro_buffer != macro_end) {
-        process_record(macro_buffer);
-        macro_buffer += direction;
-#ifdef DYNAMIC_MACRO_DELAY
-        wait_ms(DYNAMIC_MACRO_DELAY);
-#endif
+    dynamic_macro_timer = timer_read();
+}
+
+/**
+ * Stop all macro playback, releasing any keys held by the macro.
+ */
+void dynamic_macro_cancel(void) {
+    if (dynamic_macro_depth == 0) {
+        return;
     }
 
+    dprintln("dynamic macro: playback cancelled");
+
     clear_keyboard();
+    layer_state_set(dynamic_macro_players[0].saved_layer_state);
+    dynamic_macro_depth = 0;
+}
+
+bool dynamic_macro_is_playing(void) {
+    return dynamic_macro_depth > 0;
+}
+
+/**
+ * Set the playback speed as a percentage of the recorded speed.
+ */
+void dynamic_macro_set_speed(uint8_t percent) {
+    dynamic_macro_speed = percent ? percent : 1;
+}
+
+/**
+ * How long to wait before playing the next event of a macro.
+ */
+static uint16_t dynamic_macro_next_delay(dynamic_macro_player_t *player) {
+#if defined(DYNAMIC_MACRO_REPLAY_TIMING)
+    uint32_t delay = dynamic_macro_decode_delay(player->pointer->delay);
+#elif defined(DYNAMIC_MACRO_DELAY)
+    uint32_t delay = player->pointer == player->begin ? 0 : DYNAMIC_MACRO_DELAY;
+#else
+    uint32_t delay = 0;
+#endif
+    delay = delay * 100 / dynamic_macro_speed;
+    return delay < UINT16_MAX ? delay : UINT16_MAX;
+}
+
+/**
+ * Play back the next due event of the innermost playing macro. Should be
+ * called from the main loop.
+ */
+void dynamic_macro_task(void) {
+    if (dynamic_macro_depth == 0) {
+        return;
+    }
 
-    layer_state_set(saved_layer_state);
+    dynamic_macro_player_t *player = &dynamic_macro_players[dynamic_macro_depth - 1];
+    if (player->pointer == player->end) {
+        clear_keyboard();
+        layer_state_set(player->saved_layer_state);
+        dynamic_macro_depth--;
+        dynamic_macro_play_user(player->direction);
+        return;
+    }
 
-    dynamic_macro_play_user(direction);
+    uint16_t delay = dynamic_macro_next_delay(player);
+    if (timer_elapsed(dynamic_macro_timer) < delay) {
+        return;
+    }
+    // Schedule from when the event was due rather than when it was played, so delays don't add up
+    dynamic_macro_timer += delay;
+
+    dynamic_macro_event_t *event  = player->pointer;
+    keyrecord_t            record = {
+        .event =
+            {
+                .key     = event->key,
+                .pressed = event->pressed,
+                .time    = timer_read() | 1,
+            },
+#ifndef NO_ACTION_TAPPING
+        .tap =
+            {
+                .interrupted = event->interrupted,
+                .count       = event->count,
+            },
+#endif
+#ifdef COMBO_ENABLE
+        .keycode = event->keycode,
+#endif
+    };
+    player->pointer += player->direction;
+
+    dynamic_macro_replaying = true;
+    process_record(&record);
+    dynamic_macro_replaying = false;
 }
 
 /**
@@ -107,7 +245,7 @@ void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_
  * @param direction[in]  Either +1 or -1, which way to iterate the buffer.
  * @param record[in]     The current keypress.
  */
-void dynamic_macro_record_key(keyrecord_t *macro_buffer, keyrecord_t **macro_pointer, keyrecord_t *macro2_end, int8_t direction, keyrecord_t *record) {
+void dynamic_macro_record_key(dynamic_macro_event_t *macro_buffer, dynamic_macro_event_t **macro_pointer, dynamic_macro_event_t *macro2_end, int8_t direction, keyrecord_t *record) {
     /* If we've just started recording, ignore all the key releases. */
     if (!record->event.pressed && *macro_pointer == macro_buffer) {
         dprintln("dynamic macro: ignoring a leading key-up event");
@@ -118,7 +256,19 @@ void dynamic_macro_record_key(keyrecord_t *macro_buffer, keyrecord_t **macro_poi
      * is safe to use before overwriting the other macro.
      */
     if (*macro_pointer - direction != macro2_end) {
-        **macro_pointer = *record;
+        dynamic_macro_event_t *event = *macro_pointer;
+
+        event->key     = record->event.key;
+        event->pressed = record->event.pressed;
+        event->delay   = *macro_pointer == macro_buffer ? 0 : dynamic_macro_encode_delay(TIMER_DIFF_16(record->event.time, dynamic_macro_last_event));
+#ifndef NO_ACTION_TAPPING
+        event->interrupted = record->tap.interrupted;
+        event->count       = record->tap.count;
+#endif
+#ifdef COMBO_ENABLE
+        event->keycode = record->keycode;
+#endif
+        dynamic_macro_last_event = record->event.time;
         *macro_pointer += direction;
     } else {
         dynamic_macro_record_key_user(direction, record);
@@ -131,13 +281,13 @@ void dynamic_macro_record_key(keyrecord_t *macro_buffer, keyrecord_t **macro_poi
  * End recording of the dynamic macro. Essentially just update the
  * pointer to the end of the macro.
  */
-void dynamic_macro_record_end(keyrecord_t *macro_buffer, keyrecord_t *macro_pointer, int8_t direction, keyrecord_t **macro_end) {
+void dynamic_macro_record_end(dynamic_macro_event_t *macro_buffer, dynamic_macro_event_t *macro_pointer, int8_t direction, dynamic_macro_event_t **macro_end) {
     dynamic_macro_record_end_user(direction);
 
     /* Do not save the keys being held when stopping the recording,
      * i.e. the keys used to access the layer DYN_REC_STOP is on.
      */
-    while (macro_pointer != macro_buffer && (macro_pointer - direction)->event.pressed) {
+    while (macro_pointer != macro_buffer && (macro_pointer - direction)->pressed) {
         dprintln("dynamic macro: trimming a trailing key-down event");
         macro_pointer -= direction;
     }
@@ -182,23 +332,23 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
      * macros or one long macro and one short macro. Or even one empty
      * and one using the whole buffer.
      */
-    static keyrecord_t macro_buffer[DYNAMIC_MACRO_SIZE];
+    static dynamic_macro_event_t macro_buffer[DYNAMIC_MACRO_SIZE];
 
     /* Pointer to the first buffer element after the first macro.
      * Initially points to the very beginning of the buffer since the
      * macro is empty. */
-    static keyrecord_t *macro_end = macro_buffer;
+    static dynamic_macro_event_t *macro_end = macro_buffer;
 
     /* The other end of the macro buffer. Serves as the beginning of
      * the second macro. */
-    static keyrecord_t *const r_macro_buffer = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
+    static dynamic_macro_event_t *const r_macro_buffer = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
 
     /* Like macro_end but for the second macro. */
-    static keyrecord_t *r_macro_end = r_macro_buffer;
+    static dynamic_macro_event_t *r_macro_end = r_macro_buffer;
 
     /* A persistent pointer to the current macro position (iterator)
      * used during the recording. */
-    static keyrecord_t *macro_pointer = NULL;
+    static dynamic_macro_event_t *macro_pointer = NULL;
 
     /* 0   - no macro is being recorded right now
      * 1,2 - either macro 1 or 2 is being recorded */
@@ -206,6 +356,18 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
 
     if (macro_id == 0) {
         /* No macro recording in progress. */
+        if (dynamic_macro_is_playing() && !dynamic_macro_replaying) {
+            /* Pressing a macro key while a macro plays stops the playback. */
+            switch (keycode) {
+                case DYN_MACRO_PLAY1:
+                case DYN_MACRO_PLAY2:
+                case DYN_REC_STOP:
+                    if (!record->event.pressed) {
+                        dynamic_macro_cancel();
+                    }
+                    return false;
+            }
+        }
         if (!record->event.pressed) {
             switch (keycode) {
                 case DYN_REC_START1:
@@ -25,16 +25,35 @@
  * because of the down-event and up-event. This is not a bug, it's the
  * intended behavior.
  *
- * Usually it should be fine to set the macro size to at least 256 but
- * there have been reports of it being too much in some users' cases,
- * so 128 is considered a safe default.
+ * Each event takes 4 bytes (6 with combos enabled). The default fits as
+ * many events as the RAM of the 128 keyrecord_t the buffer used to hold,
+ * so existing keyboards keep their memory budget.
  */
 #ifndef DYNAMIC_MACRO_SIZE
-#    define DYNAMIC_MACRO_SIZE 128
+#    define DYNAMIC_MACRO_SIZE (128 * sizeof(keyrecord_t) / sizeof(dynamic_macro_event_t))
 #endif
 
+/* Compact form of a recorded keyrecord_t. */
+typedef struct {
+    keypos_t key;
+    uint8_t  pressed : 1;
+#ifndef NO_ACTION_TAPPING
+    uint8_t interrupted : 1;
+    uint8_t count : 4;
+#endif
+    // time since the previous event, see dynamic_macro_encode_delay()
+    uint8_t delay;
+#ifdef COMBO_ENABLE
+    uint16_t keycode;
+#endif
+} __attribute__((packed)) dynamic_macro_event_t;
+
 void dynamic_macro_led_blink(void);
 bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record);
+void dynamic_macro_task(void);
+bool dynamic_macro_is_playing(void);
+void dynamic_macro_cancel(void);
+void dynamic_macro_set_speed(uint8_t percent);
 void dynamic_macro_record_start_user(void);
 void dynamic_macro_play_user(int8_t direction);
 void dynamic_macro_record_key_user(int8_t direction, keyrecord_t *record);
@@ -26,6 +26,11 @@
 #    define KEY_OVERRIDE_REPEAT_DELAY 500
 #endif
 
+// Number of key overrides the trigger index can hold, set it to the length of key_overrides to enable the index. Overrides past this many are tried one by one on each event.
+#ifndef KEY_OVERRIDE_INDEX_SIZE
+#    define KEY_OVERRIDE_INDEX_SIZE 0
+#endif
+
 // For benchmarking the time it takes to call process_key_override on every key press (needs keyboard debugging enabled as well)
 // #define BENCH_KEY_OVERRIDE
 
@@ -243,141 +248,280 @@ static bool check_activation_event(const key_override_t *override, const bool ke
     }
 }
 
-/** Iterates through the list of key overrides and tries activating each, until it finds one that activates or reaches the end of overrides. Returns true if the key action for `keycode` should be sent */
-static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
-    if (key_overrides == NULL) {
-        return true;
+/** Checks whether the override can activate for this event. */
+static bool override_can_activate(const key_override_t *const override, const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods) {
+    // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
+    if (active_mods == 0 && override->trigger_mods != 0) {
+        key_override_printf("Not activating override: Modifiers don't match\n");
+        return false;
     }
 
-    for (uint8_t i = 0;; i++) {
-        const key_override_t *const override = key_overrides[i];
+    // Check layer
+    if ((override->layers & (1 << layer)) == 0) {
+        key_override_printf("Not activating override: Not set to activate on pressed layer\n");
+        return false;
+    }
 
-        // End of array
-        if (override == NULL) {
-            break;
-        }
+    // Check allowed activation events
+    if (!check_activation_event(override, key_down, is_mod)) {
+        key_override_printf("Not activating override: Activation event not allowed\n");
+        return false;
+    }
 
-        // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
-        if (active_mods == 0 && override->trigger_mods != 0) {
-            key_override_printf("Not activating override: Modifiers don't match\n");
-            continue;
-        }
+    const bool is_trigger = override->trigger == keycode;
 
-        // Check layer
-        if ((override->layers & (1 << layer)) == 0) {
-            key_override_printf("Not activating override: Not set to activate on pressed layer\n");
-            continue;
-        }
+    // Check if trigger lifted. This is a small optimization in order to skip the remaining checks
+    if (is_trigger && !key_down) {
+        key_override_printf("Not activating override: Trigger lifted\n");
+        return false;
+    }
 
-        // Check allowed activation events
-        if (!check_activation_event(override, key_down, is_mod)) {
-            key_override_printf("Not activating override: Activation event not allowed\n");
-            continue;
-        }
+    // Check if aleady active
+    if (override == active_override) {
+        key_override_printf("Not activating override: Alerady actived\n");
+        return false;
+    }
+
+    // Check if enabled
+    if (override->enabled != NULL && !((*(override->enabled) & 1))) {
+        key_override_printf("Not activating override: Not enabled\n");
+        return false;
+    }
 
-        const bool is_trigger = override->trigger == keycode;
+    // Check mods precisely
+    if (!key_override_matches_active_modifiers(override, active_mods)) {
+        key_override_printf("Not activating override: Modifiers don't match\n");
+        return false;
+    }
 
-        // Check if trigger lifted. This is a small optimization in order to skip the remaining checks
-        if (is_trigger && !key_down) {
-            key_override_printf("Not activating override: Trigger lifted\n");
-            continue;
-        }
+    // At this point, all requirements for activation are checked, except whether the trigger key is pressed. Now we check if the required trigger is down
+    // If no trigger key is required, yes.
+    // If the trigger was just pressed, yes.
+    // If the last non-mod key that was pressed down is the trigger key, yes.
+    if (override->trigger != KC_NO && !(is_trigger && key_down) && last_key_down != override->trigger) {
+        key_override_printf("Not activating override. Trigger not down\n");
+        return false;
+    }
 
-        // If the trigger is KC_NO it means 'no key', so only the required modifiers need to be down.
-        const bool no_trigger = override->trigger == KC_NO;
+    return true;
+}
 
-        // Check if aleady active
-        if (override == active_override) {
-            key_override_printf("Not activating override: Alerady actived\n");
-            continue;
-        }
+/** Activates the override. Returns true if the key action for `keycode` should be sent */
+static bool activate_override(const key_override_t *const override, const uint16_t keycode, const bool key_down, const bool is_mod) {
+    // If the trigger is KC_NO it means 'no key', so only the required modifiers need to be down.
+    const bool no_trigger = override->trigger == KC_NO;
 
-        // Check if enabled
-        if (override->enabled != NULL && !((*(override->enabled) & 1))) {
-            key_override_printf("Not activating override: Not enabled\n");
-            continue;
-        }
+    // Check if trigger key is down.
+    const bool trigger_down = override->trigger == keycode && key_down;
 
-        // Check mods precisely
-        if (!key_override_matches_active_modifiers(override, active_mods)) {
-            key_override_printf("Not activating override: Modifiers don't match\n");
-            continue;
-        }
+    key_override_printf("Activating override\n");
+
+    clear_active_override(false);
 
-        // Check if trigger key is down.
-        const bool trigger_down = is_trigger && key_down;
+    active_override                 = override;
+    active_override_trigger_is_down = true;
 
-        // At this point, all requirements for activation are checked, except whether the trigger key is pressed. Now we check if the required trigger is down
-        // If no trigger key is required, yes.
-        // If the trigger was just pressed, yes.
-        // If the last non-mod key that was pressed down is the trigger key, yes.
-        bool should_activate = no_trigger || trigger_down || last_key_down == override->trigger;
+    set_suppressed_override_mods(override->suppressed_mods);
 
-        if (!should_activate) {
-            key_override_printf("Not activating override. Trigger not down\n");
-            continue;
+    if (!trigger_down && !no_trigger) {
+        // When activating a key override the trigger is is always unregistered. In the case where the key that newly pressed is not the trigger key, we have to explicitly remove the trigger key from the keyboard report. If the trigger was just pressed down we simply suppress the event which also has the effect of the trigger key not being registered in the keyboard report.
+        if (IS_KEY(override->trigger)) {
+            del_key(override->trigger);
+        } else {
+            unregister_code(override->trigger);
         }
+    }
 
-        key_override_printf("Activating override\n");
+    const uint16_t mod_free_replacement = clear_mods_from(override->replacement);
 
-        clear_active_override(false);
+    bool register_replacement = mod_free_replacement != KC_NO &&   // KC_NO is never registered
+                                mod_free_replacement < SAFE_RANGE; // Custom keycodes are never registered
 
-        active_override                 = override;
-        active_override_trigger_is_down = true;
+    // Try firing the custom handler
+    if (override->custom_action != NULL) {
+        register_replacement &= override->custom_action(true, override->context);
+    }
 
-        set_suppressed_override_mods(override->suppressed_mods);
+    if (register_replacement) {
+        const uint8_t override_mods = extract_mod_bits(override->replacement);
+        set_weak_override_mods(override_mods);
 
-        if (!trigger_down && !no_trigger) {
-            // When activating a key override the trigger is is always unregistered. In the case where the key that newly pressed is not the trigger key, we have to explicitly remove the trigger key from the keyboard report. If the trigger was just pressed down we simply suppress the event which also has the effect of the trigger key not being registered in the keyboard report.
-            if (IS_KEY(override->trigger)) {
-                del_key(override->trigger);
+        // If this is a modifier event that activates the key override we _always_ defer the actual full activation of the override
+        if (is_mod) {
+            key_override_printf("Deferring register replacement key\n");
+            schedule_deferred_register(mod_free_replacement);
+            send_keyboard_report();
+        } else {
+            if (IS_KEY(mod_free_replacement)) {
+                add_key(mod_free_replacement);
             } else {
-                unregister_code(override->trigger);
+                key_override_printf("NOT KEY 2\n");
+                send_keyboard_report();
+                // On macOS there seems to be a race condition when it comes to the keyboard report and consumer keycodes. It seems the OS may recognize a consumer keycode before an updated keyboard report, even if the keyboard report is actually sent before the consumer key. I assume it is some sort of race condition because it happens infrequently and very irregularly. Waiting for about at least 10ms between sending the keyboard report and sending the consumer code has shown to fix this.
+                flush_keyboard_report();
+                wait_ms(10);
+                register_code(mod_free_replacement);
             }
         }
+    } else {
+        // If not registering the replacement key send keyboard report to update the unregistered keys.
+        send_keyboard_report();
+    }
+
+    // If the trigger is down, suppress the event so that it does not get added to the keyboard report.
+    return !trigger_down;
+}
+
+#if KEY_OVERRIDE_INDEX_SIZE > 0
+/* Index of key_overrides by trigger keycode: positions in key_overrides, sorted by trigger and
+ * then by position. Only the overrides whose trigger can be down at all - the key of the event,
+ * the last non-mod key pressed, or KC_NO - are candidates for an event, and each of those is
+ * one contiguous run of the index, so an event only looks at a handful of overrides no matter
+ * how many there are. Built on first use, and again whenever key_overrides points elsewhere.
+ */
+#    if KEY_OVERRIDE_INDEX_SIZE <= 256
+typedef uint8_t override_position_t;
+#    else
+typedef uint16_t override_position_t;
+#    endif
+
+static override_position_t    override_index[KEY_OVERRIDE_INDEX_SIZE];
+static uint16_t               override_index_length  = 0;
+static const key_override_t **override_index_source  = NULL;
+static bool                   override_index_partial = false;
+
+#    ifdef KEY_OVERRIDE_TESTS
+// Lets the tests time the linear scan against the index in the same build
+bool key_override_index_bypass = false;
+#    endif
+
+void key_override_index_invalidate(void) {
+    override_index_source = NULL;
+}
 
-        const uint16_t mod_free_replacement = clear_mods_from(override->replacement);
+static void build_override_index(void) {
+    override_index_source  = key_overrides;
+    override_index_length  = 0;
+    override_index_partial = false;
+
+    for (uint16_t i = 0; key_overrides[i] != NULL; i++) {
+        if (i == KEY_OVERRIDE_INDEX_SIZE) {
+            // The remaining overrides are tried one by one after the indexed ones, which all come before them
+            dprintf("key_overrides has more than KEY_OVERRIDE_INDEX_SIZE (%u) entries, the rest are not indexed\n", KEY_OVERRIDE_INDEX_SIZE);
+            override_index_partial = true;
+            return;
+        }
 
-        bool register_replacement = mod_free_replacement != KC_NO &&   // KC_NO is never registered
-                                    mod_free_replacement < SAFE_RANGE; // Custom keycodes are never registered
+        // Insertion sort by trigger; overrides with the same trigger keep their order
+        const uint16_t trigger = key_overrides[i]->trigger;
+        uint16_t       j       = override_index_length++;
+        while (j > 0 && key_overrides[override_index[j - 1]]->trigger > trigger) {
+            override_index[j] = override_index[j - 1];
+            j--;
+        }
+        override_index[j] = i;
+    }
+}
 
-        // Try firing the custom handler
-        if (override->custom_action != NULL) {
-            register_replacement &= override->custom_action(true, override->context);
+/** Finds the run of the index holding the overrides for `trigger`, as [*first, return value) */
+static uint16_t find_override_run(const uint16_t trigger, uint16_t *first) {
+    uint16_t low  = 0;
+    uint16_t high = override_index_length;
+    while (low < high) {
+        const uint16_t middle = low + (high - low) / 2;
+        if (key_overrides[override_index[middle]]->trigger < trigger) {
+            low = middle + 1;
+        } else {
+            high = middle;
         }
+    }
+    *first = low;
+    while (high < override_index_length && key_overrides[override_index[high]]->trigger == trigger) {
+        high++;
+    }
+    return high;
+}
+#else
+void key_override_index_invalidate(void) {}
+#endif
 
-        if (register_replacement) {
-            const uint8_t override_mods = extract_mod_bits(override->replacement);
-            set_weak_override_mods(override_mods);
+/** Tries activating the key overrides in the order they are listed in, until one activates or all have been tried. Returns true if the key action for `keycode` should be sent */
+static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
+    *activated = false;
 
-            // If this is a modifier event that activates the key override we _always_ defer the actual full activation of the override
-            if (is_mod) {
-                key_override_printf("Deferring register replacement key\n");
-                schedule_deferred_register(mod_free_replacement);
-                send_keyboard_report();
-            } else {
-                if (IS_KEY(mod_free_replacement)) {
-                    add_key(mod_free_replacement);
-                } else {
-                    key_override_printf("NOT KEY 2\n");
-                    send_keyboard_report();
-                    // On macOS there seems to be a race condition when it comes to the keyboard report and consumer keycodes. It seems the OS may recognize a consumer keycode before an updated keyboard report, even if the keyboard report is actually sent before the consumer key. I assume it is some sort of race condition because it happens infrequently and very irregularly. Waiting for about at least 10ms between sending the keyboard report and sending the consumer code has shown to fix this.
-                    wait_ms(10);
-                    register_code(mod_free_replacement);
-                }
+    if (key_overrides == NULL) {
+        return true;
+    }
+
+    uint16_t first_unindexed = 0;
+
+#if KEY_OVERRIDE_INDEX_SIZE > 0
+    if (override_index_source != key_overrides) {
+        build_override_index();
+    }
+
+#    ifdef KEY_OVERRIDE_TESTS
+    if (!key_override_index_bypass)
+#    endif
+    {
+        // The candidate triggers, each with its run of the index. Runs are merged by position, so that the first listed override still wins.
+        const uint16_t triggers[]      = {keycode, last_key_down, KC_NO};
+        uint16_t       next[3]         = {0};
+        uint16_t       end[3]          = {0};
+        uint8_t        candidate_lists = 0;
+
+        for (uint8_t t = 0; t < 3; t++) {
+            bool duplicate = false;
+            for (uint8_t u = 0; u < t; u++) {
+                duplicate |= triggers[u] == triggers[t];
+            }
+            if (!duplicate) {
+                end[candidate_lists] = find_override_run(triggers[t], &next[candidate_lists]);
+                candidate_lists++;
             }
-        } else {
-            // If not registering the replacement key send keyboard report to update the unregistered keys.
-            send_keyboard_report();
         }
 
-        *activated = true;
+        while (true) {
+            uint8_t  list     = UINT8_MAX;
+            uint16_t position = UINT16_MAX;
+            for (uint8_t l = 0; l < candidate_lists; l++) {
+                if (next[l] < end[l] && override_index[next[l]] < position) {
+                    list     = l;
+                    position = override_index[next[l]];
+                }
+            }
+            if (list == UINT8_MAX) {
+                break;
+            }
+            next[list]++;
+
+            const key_override_t *const override = key_overrides[position];
+            if (override_can_activate(override, keycode, layer, key_down, is_mod, active_mods)) {
+                *activated = true;
+                return activate_override(override, keycode, key_down, is_mod);
+            }
+        }
 
-        // If the trigger is down, suppress the event so that it does not get added to the keyboard report.
-        return !trigger_down;
+        if (!override_index_partial) {
+            return true;
+        }
+        first_unindexed = KEY_OVERRIDE_INDEX_SIZE;
     }
+#endif
 
-    *activated = false;
+    for (uint16_t i = first_unindexed;; i++) {
+        const key_override_t *const override = key_overrides[i];
+
+        // End of array
+        if (override == NULL) {
+            break;
+        }
+
+        if (override_can_activate(override, keycode, layer, key_down, is_mod, active_mods)) {
+            *activated = true;
+            return activate_override(override, keycode, key_down, is_mod);
+        }
+    }
 
     return true;
 }
@@ -396,7 +540,7 @@ void key_override_task(void) {
     }
 }
 
-bool process_key_override(const uint16_t keycode, const keyrecord_t *const record) {
+bool process_key_override(uint16_t keycode, keyrecord_t *record) {
 #ifdef BENCH_KEY_OVERRIDE
     uint16_t start = timer_read();
 #endif
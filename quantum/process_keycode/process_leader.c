@@ -31,8 +31,157 @@ __attribute__((weak)) void leader_end(void) {}
 bool     leading     = false;
 uint16_t leader_time = 0;
 
-uint16_t leader_sequence[5]   = {0, 0, 0, 0, 0};
-uint8_t  leader_sequence_size = 0;
+uint16_t leader_sequence[LEADER_MAX_SEQUENCE_LENGTH] = {0};
+uint8_t  leader_sequence_size                        = 0;
+
+#    ifdef LEADER_SEQUENCE_COUNT
+__attribute__((weak)) leader_sequence_t leader_sequences[LEADER_SEQUENCE_COUNT];
+
+__attribute__((weak)) void process_leader_event(uint16_t sequence_index) {}
+
+#        if LEADER_SEQUENCE_COUNT <= 256
+typedef uint8_t leader_index_t;
+#        else
+typedef uint16_t leader_index_t;
+#        endif
+
+/* The sequence table in lexicographic order of the keys, through indices so that
+ * process_leader_event still gets the position in leader_sequences. Together with the
+ * sequence end sorting before any keycode, this is a flattened prefix trie: the sequences
+ * starting with the keys typed so far always form one contiguous range, and each key
+ * narrows that range down by binary search.
+ */
+static leader_index_t leader_order[LEADER_SEQUENCE_COUNT];
+static bool           leader_order_ready = false;
+// Range of leader_order whose sequences start with the keys typed so far
+static uint16_t leader_match_first = 0;
+static uint16_t leader_match_end   = 0;
+// Number of keys typed so far, which can exceed the length of leader_sequence
+static uint8_t leader_depth = 0;
+
+static inline uint16_t leader_sequence_key(uint16_t order, uint8_t depth) {
+    return pgm_read_word(&leader_sequences[leader_order[order]].keys[depth]);
+}
+
+static int8_t leader_compare(leader_index_t a, leader_index_t b) {
+    const uint16_t *keys_a = leader_sequences[a].keys;
+    const uint16_t *keys_b = leader_sequences[b].keys;
+    for (;; keys_a++, keys_b++) {
+        uint16_t key_a = pgm_read_word(keys_a);
+        uint16_t key_b = pgm_read_word(keys_b);
+        if (key_a != key_b) {
+            return key_a < key_b ? -1 : 1;
+        }
+        if (key_a == LEADER_END) {
+            return 0;
+        }
+    }
+}
+
+static void leader_sort_sequences(void) {
+    // Insertion sort: done once, and stable so that the first of two identical sequences wins
+    for (uint16_t i = 0; i < LEADER_SEQUENCE_COUNT; i++) {
+        uint16_t j = i;
+        while (j > 0 && leader_compare(leader_order[j - 1], i) > 0) {
+            leader_order[j] = leader_order[j - 1];
+            j--;
+        }
+        leader_order[j] = i;
+    }
+    leader_order_ready = true;
+}
+
+// First position in [first, end) whose key at `depth` is not less than `keycode` (or greater, if `after`)
+static uint16_t leader_search(uint16_t first, uint16_t end, uint8_t depth, uint16_t keycode, bool after) {
+    while (first < end) {
+        uint16_t middle = first + (end - first) / 2;
+        uint16_t key    = leader_sequence_key(middle, depth);
+        if (key < keycode || (after && key == keycode)) {
+            first = middle + 1;
+        } else {
+            end = middle;
+        }
+    }
+    return first;
+}
+
+static void leader_match_reset(void) {
+    if (!leader_order_ready) {
+        leader_sort_sequences();
+    }
+    leader_match_first = 0;
+    leader_match_end   = LEADER_SEQUENCE_COUNT;
+    leader_depth       = 0;
+}
+
+// Whether the keys typed so far form one of the sequences; it is the first of the range if so
+static inline bool leader_match_is_complete(void) {
+    return leader_match_first < leader_match_end && leader_sequence_key(leader_match_first, leader_depth) == LEADER_END;
+}
+
+static void leader_match_fire(void) {
+    leader_index_t index = leader_order[leader_match_first];
+
+    leading = false;
+    if (leader_sequences[index].keycode) {
+        tap_code16(leader_sequences[index].keycode);
+    } else {
+        process_leader_event(index);
+    }
+    leader_end();
+}
+
+/**
+ * \brief Narrows the matching sequences down by one more key
+ *
+ * \return true when the key is part of a sequence in the table
+ */
+static bool leader_match_key(uint16_t keycode) {
+    if (leader_match_first == leader_match_end || keycode == LEADER_END) {
+        leader_match_end = leader_match_first;
+        return false;
+    }
+    leader_match_first = leader_search(leader_match_first, leader_match_end, leader_depth, keycode, false);
+    leader_match_end   = leader_search(leader_match_first, leader_match_end, leader_depth, keycode, true);
+    leader_depth++;
+
+    // Unambiguous: no other sequence starts with these keys, so there is no need to wait for more
+    if (leader_match_end - leader_match_first == 1 && leader_match_is_complete()) {
+        leader_match_fire();
+    }
+    return leader_match_first < leader_match_end;
+}
+
+/**
+ * \brief Whether the keys typed so far form a sequence of the table
+ *
+ * LEADER_DICTIONARY() checks this so that it leaves these to leader_task, even though
+ * matrix_scan_user runs first.
+ */
+bool leader_sequence_in_table(void) {
+    return leading && leader_match_is_complete();
+}
+
+/**
+ * \brief Fires the typed sequence once the leader timeout has passed
+ *
+ * Sequences which are the start of longer ones can only fire here. Anything not in the
+ * table is left for LEADER_DICTIONARY() in matrix_scan_user.
+ */
+void leader_task(void) {
+    if (!leading || !leader_match_is_complete()) {
+        return;
+    }
+#        ifdef LEADER_NO_TIMEOUT
+    if (leader_sequence_size == 0) {
+        return;
+    }
+#        endif
+    if (timer_elapsed(leader_time) > LEADER_TIMEOUT) {
+        leader_match_fire();
+    }
+}
+#    endif // LEADER_SEQUENCE_COUNT
 
 void qk_leader_start(void) {
     if (leading) {
@@ -43,6 +192,9 @@ void qk_leader_start(void) {
     leader_time          = timer_read();
     leader_sequence_size = 0;
     memset(leader_sequence, 0, sizeof(leader_sequence));
+#    ifdef LEADER_SEQUENCE_COUNT
+    leader_match_reset();
+#    endif
 }
 
 bool process_leader(uint16_t keycode, keyrecord_t *record) {
@@ -58,10 +210,19 @@ bool process_leader(uint16_t keycode, keyrecord_t *record) {
                     keycode = keycode & 0xFF;
                 }
 #    endif // LEADER_KEY_STRICT_KEY_PROCESSING
+#    ifdef LEADER_SEQUENCE_COUNT
+                // Sequences in the table may be longer than leader_sequence
+                bool in_table = leader_match_key(keycode);
+                if (!leading) {
+                    return false;
+                }
+#    else
+                const bool in_table = false;
+#    endif
                 if (leader_sequence_size < (sizeof(leader_sequence) / sizeof(leader_sequence[0]))) {
                     leader_sequence[leader_sequence_size] = keycode;
                     leader_sequence_size++;
-                } else {
+                } else if (!in_table) {
                     leading = false;
                     leader_end();
                     return true;
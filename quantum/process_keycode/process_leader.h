@@ -18,26 +18,52 @@
 
 #include "quantum.h"
 
+#ifndef LEADER_MAX_SEQUENCE_LENGTH
+#    define LEADER_MAX_SEQUENCE_LENGTH 5
+#endif
+
 bool process_leader(uint16_t keycode, keyrecord_t *record);
 
 void leader_start(void);
 void leader_end(void);
 void qk_leader_start(void);
 
-#define SEQ_ONE_KEY(key) if (leader_sequence[0] == (key) && leader_sequence[1] == 0 && leader_sequence[2] == 0 && leader_sequence[3] == 0 && leader_sequence[4] == 0)
-#define SEQ_TWO_KEYS(key1, key2) if (leader_sequence[0] == (key1) && leader_sequence[1] == (key2) && leader_sequence[2] == 0 && leader_sequence[3] == 0 && leader_sequence[4] == 0)
-#define SEQ_THREE_KEYS(key1, key2, key3) if (leader_sequence[0] == (key1) && leader_sequence[1] == (key2) && leader_sequence[2] == (key3) && leader_sequence[3] == 0 && leader_sequence[4] == 0)
-#define SEQ_FOUR_KEYS(key1, key2, key3, key4) if (leader_sequence[0] == (key1) && leader_sequence[1] == (key2) && leader_sequence[2] == (key3) && leader_sequence[3] == (key4) && leader_sequence[4] == 0)
-#define SEQ_FIVE_KEYS(key1, key2, key3, key4, key5) if (leader_sequence[0] == (key1) && leader_sequence[1] == (key2) && leader_sequence[2] == (key3) && leader_sequence[3] == (key4) && leader_sequence[4] == (key5))
+#ifdef LEADER_SEQUENCE_COUNT
+typedef struct {
+    const uint16_t *keys; // PROGMEM, terminated by LEADER_END
+    uint16_t        keycode;
+} leader_sequence_t;
+
+#    define LEADER_SEQ(seq, kc) \
+        { .keys = &(seq)[0], .keycode = (kc) }
+#    define LEADER_SEQ_ACTION(seq) \
+        { .keys = &(seq)[0] }
+
+#    define LEADER_END 0
+
+void leader_task(void);
+void process_leader_event(uint16_t sequence_index);
+bool leader_sequence_in_table(void);
+#    define LEADER_TABLE_MATCHED() leader_sequence_in_table()
+#else
+#    define LEADER_TABLE_MATCHED() false
+#endif
+
+#define SEQ_ONE_KEY(key) if (leader_sequence_size == 1 && leader_sequence[0] == (key))
+#define SEQ_TWO_KEYS(key1, key2) if (leader_sequence_size == 2 && leader_sequence[0] == (key1) && leader_sequence[1] == (key2))
+#define SEQ_THREE_KEYS(key1, key2, key3) if (leader_sequence_size == 3 && leader_sequence[0] == (key1) && leader_sequence[1] == (key2) && leader_sequence[2] == (key3))
+#define SEQ_FOUR_KEYS(key1, key2, key3, key4) if (leader_sequence_size == 4 && leader_sequence[0] == (key1) && leader_sequence[1] == (key2) && leader_sequence[2] == (key3) && leader_sequence[3] == (key4))
+#define SEQ_FIVE_KEYS(key1, key2, key3, key4, key5) if (leader_sequence_size == 5 && leader_sequence[0] == (key1) && leader_sequence[1] == (key2) && leader_sequence[2] == (key3) && leader_sequence[3] == (key4) && leader_sequence[4] == (key5))
 
-#define LEADER_EXTERNS()                \
-    extern bool     leading;            \
-    extern uint16_t leader_time;        \
-    extern uint16_t leader_sequence[5]; \
+#define LEADER_EXTERNS()                                         \
+    extern bool     leading;                                     \
+    extern uint16_t leader_time;                                 \
+    extern uint16_t leader_sequence[LEADER_MAX_SEQUENCE_LENGTH]; \
     extern uint8_t  leader_sequence_size
 
+// Sequences in the leader_sequences table are left to leader_task, even when they are a prefix of another one
 #ifdef LEADER_NO_TIMEOUT
-#    define LEADER_DICTIONARY() if (leading && leader_sequence_size > 0 && timer_elapsed(leader_time) > LEADER_TIMEOUT)
+#    define LEADER_DICTIONARY() if (leading && leader_sequence_size > 0 && !LEADER_TABLE_MATCHED() && timer_elapsed(leader_time) > LEADER_TIMEOUT)
 #else
-#    define LEADER_DICTIONARY() if (leading && timer_elapsed(leader_time) > LEADER_TIMEOUT)
+#    define LEADER_DICTIONARY() if (leading && !LEADER_TABLE_MATCHED() && timer_elapsed(leader_time) > LEADER_TIMEOUT)
 #endif
@@ -50,7 +50,7 @@ static void __attribute__((noinline, unused)) handleKeycodeRGBMode(const uint8_t
 /**
  * Handle keycodes for both rgblight and rgbmatrix
  */
-bool process_rgb(const uint16_t keycode, const keyrecord_t *record) {
+bool process_rgb(const uint16_t keycode, keyrecord_t *record) {
     // need to trigger on key-up for edge-case issue
 #ifndef RGB_TRIGGER_ON_KEYDOWN
     if (!record->event.pressed) {
@@ -17,4 +17,4 @@
 
 #include "quantum.h"
 
-bool process_rgb(const uint16_t keycode, const keyrecord_t *record);
+bool process_rgb(const uint16_t keycode, keyrecord_t *record);
@@ -24,8 +24,7 @@
 #    include "eeprom.h"
 #endif
 
-// All steno keys that have been pressed to form this chord,
-// stored in MAX_STROKE_SIZE groups of 8-bit arrays.
+// The packet of the current chord, as encoded by the protocol in use.
 static uint8_t chord[MAX_STROKE_SIZE] = {0};
 // The number of physical keys actually being held down.
 // This is not always equal to the number of 1 bits in `chord` because it is possible to
@@ -41,43 +40,49 @@ static steno_mode_t mode;
 static const steno_mode_t mode = STENO_MODE_GEMINI;
 #elif defined(STENO_ENABLE_BOLT)
 static const steno_mode_t mode = STENO_MODE_BOLT;
+#elif defined(STENO_ENABLE_HID)
+static const steno_mode_t mode = STENO_MODE_HID;
 #endif
 
+/* A protocol backend: `encode` adds one pressed key to the packet handed to the hooks,
+ * `send` transmits that packet once the chord is complete.
+ */
+typedef struct {
+    void (*encode)(uint8_t key, uint8_t chord[MAX_STROKE_SIZE]);
+    void (*send)(uint8_t chord[MAX_STROKE_SIZE]);
+} steno_protocol_t;
+
 static inline void steno_clear_chord(void) {
     memset(chord, 0, sizeof(chord));
 }
 
-#ifdef STENO_ENABLE_GEMINI
+#if defined(STENO_ENABLE_GEMINI) || defined(STENO_ENABLE_HID)
 
-#    ifdef VIRTSER_ENABLE
-void send_steno_chord_gemini(void) {
-    // Set MSB to 1 to indicate the start of packet
-    chord[0] |= 0x80;
-    for (uint8_t i = 0; i < GEMINI_STROKE_SIZE; ++i) {
-        virtser_send(chord[i]);
-    }
-}
-#    else
-#        pragma message "VIRTSER_ENABLE = yes is required for Gemini PR to work properly out of the box!"
-#    endif // VIRTSER_ENABLE
-
-/**
- * @precondition: `key` is pressed
- */
-bool add_gemini_key_to_chord(uint8_t key) {
+static void encode_gemini(uint8_t key, uint8_t chord[MAX_STROKE_SIZE]) {
     // Although each group of the packet is 8 bits long, the MSB is reserved
     // to indicate whether that byte is the first byte of the packet (MSB=1)
     // or one of the remaining five bytes of the packet (MSB=0).
     // As a consequence, only 7 out of the 8 bits are left to be used as a bit array
     // for the steno keys of that group.
-    const int group_idx       = key / 7;
-    const int intra_group_idx = key - group_idx * 7;
+    const uint8_t group_idx       = key / 7;
+    const uint8_t intra_group_idx = key - group_idx * 7;
     // The 0th steno key of the group has bit=0b01000000, the 1st has bit=0b00100000, etc.
-    const uint8_t bit = 1 << (6 - intra_group_idx);
-    chord[group_idx] |= bit;
-    return false;
+    chord[group_idx] |= 1 << (6 - intra_group_idx);
+}
+#endif // STENO_ENABLE_GEMINI || STENO_ENABLE_HID
+
+#ifdef STENO_ENABLE_GEMINI
+#    ifdef VIRTSER_ENABLE
+static void send_steno_chord_gemini(uint8_t chord[MAX_STROKE_SIZE]) {
+    // Set MSB to 1 to indicate the start of packet
+    chord[0] |= 0x80;
+    virtser_send_buffer(chord, GEMINI_STROKE_SIZE);
 }
-#endif // STENO_ENABLE_GEMINI
+#    else
+#        define send_steno_chord_gemini NULL
+#        pragma message "VIRTSER_ENABLE = yes is required for Gemini PR to work properly out of the box!"
+#    endif // VIRTSER_ENABLE
+#endif     // STENO_ENABLE_GEMINI
 
 #ifdef STENO_ENABLE_BOLT
 
@@ -91,34 +96,108 @@ bool add_gemini_key_to_chord(uint8_t key) {
 
 static const uint8_t boltmap[64] PROGMEM = {TXB_NUL, TXB_NUM, TXB_NUM, TXB_NUM, TXB_NUM, TXB_NUM, TXB_NUM, TXB_S_L, TXB_S_L, TXB_T_L, TXB_K_L, TXB_P_L, TXB_W_L, TXB_H_L, TXB_R_L, TXB_A_L, TXB_O_L, TXB_STR, TXB_STR, TXB_NUL, TXB_NUL, TXB_NUL, TXB_STR, TXB_STR, TXB_E_R, TXB_U_R, TXB_F_R, TXB_R_R, TXB_P_R, TXB_B_R, TXB_L_R, TXB_G_R, TXB_T_R, TXB_S_R, TXB_D_R, TXB_NUM, TXB_NUM, TXB_NUM, TXB_NUM, TXB_NUM, TXB_NUM, TXB_Z_R};
 
+static void encode_bolt(uint8_t key, uint8_t chord[MAX_STROKE_SIZE]) {
+    uint8_t boltcode = pgm_read_byte(boltmap + key);
+    chord[TXB_GET_GROUP(boltcode)] |= boltcode;
+}
+
 #    ifdef VIRTSER_ENABLE
-static void send_steno_chord_bolt(void) {
+static void send_steno_chord_bolt(uint8_t chord[MAX_STROKE_SIZE]) {
+    uint8_t packet[BOLT_STROKE_SIZE + 1];
+    uint8_t length = 0;
     for (uint8_t i = 0; i < BOLT_STROKE_SIZE; ++i) {
         // TX Bolt uses variable length packets where each byte corresponds to a bit array of certain keys.
         // If a user chorded the keys of the first group with keys of the last group, for example, there
         // would be bytes of 0x00 in `chord` for the middle groups which we mustn't send.
         if (chord[i]) {
-            virtser_send(chord[i]);
+            packet[length++] = chord[i];
         }
     }
     // Sending a null packet is not always necessary, but it is simpler and more reliable
     // to unconditionally send it every time instead of keeping track of more states and
     // creating more branches in the execution of the program.
-    virtser_send(0);
+    packet[length++] = 0;
+    virtser_send_buffer(packet, length);
 }
 #    else
+#        define send_steno_chord_bolt NULL
 #        pragma message "VIRTSER_ENABLE = yes is required for TX Bolt to work properly out of the box!"
 #    endif // VIRTSER_ENABLE
+#endif     // STENO_ENABLE_BOLT
 
-/**
- * @precondition: `key` is pressed
+#ifdef STENO_ENABLE_HID
+/* Plover's default layout for its "Keyboard" machine, which reads the chord from regular key
+ * presses. Keys without a QWERTY position (Fn, the reserved keys and power) are not sent.
  */
-static bool add_bolt_key_to_chord(uint8_t key) {
-    uint8_t boltcode = pgm_read_byte(boltmap + key);
-    chord[TXB_GET_GROUP(boltcode)] |= boltcode;
-    return false;
+// clang-format off
+static const uint8_t hidmap[GEMINI_STROKE_SIZE * 7] PROGMEM = {
+    KC_NO, KC_1, KC_2, KC_3, KC_4,    KC_5,    KC_6,    // Fn  #1  #2  #3  #4  #5   #6
+    KC_Q,  KC_A, KC_W, KC_S, KC_E,    KC_D,    KC_R,    // S1- S2- T-  K-  P-  W-   H-
+    KC_F,  KC_C, KC_V, KC_T, KC_G,    KC_NO,   KC_NO,   // R-  A-  O-  *1  *2  res1 res2
+    KC_NO, KC_Y, KC_H, KC_N, KC_M,    KC_U,    KC_J,    // pwr *3  *4  -E  -U  -F   -R
+    KC_I,  KC_K, KC_O, KC_L, KC_P,    KC_SCLN, KC_LBRC, // -P  -B  -L  -G  -T  -S   -D
+    KC_7,  KC_8, KC_9, KC_0, KC_MINS, KC_EQL,  KC_QUOT, // #7  #8  #9  #A  #B  #C   -Z
+};
+// clang-format on
+
+/* Types the chord as simultaneously held keys, released all at once at the end. Without NKRO
+ * the held keys slide through the six slots of the report, so that at least one key of the
+ * chord stays down until the final release and the host still reads it as a single stroke.
+ */
+static void send_steno_chord_hid(uint8_t chord[MAX_STROKE_SIZE]) {
+    uint8_t keys[GEMINI_STROKE_SIZE * 7];
+    uint8_t n_keys = 0;
+    for (uint8_t group_idx = 0; group_idx < GEMINI_STROKE_SIZE; group_idx++) {
+        for (uint8_t intra_group_idx = 0; intra_group_idx < 7; intra_group_idx++) {
+            if (chord[group_idx] & (1 << (6 - intra_group_idx))) {
+                uint8_t code = pgm_read_byte(hidmap + group_idx * 7 + intra_group_idx);
+                if (code != KC_NO) {
+                    keys[n_keys++] = code;
+                }
+            }
+        }
+    }
+    if (n_keys == 0) {
+        return;
+    }
+
+    bool window = true;
+#    ifdef NKRO_ENABLE
+    window = !(keyboard_protocol && keymap_config.nkro);
+#    endif
+    for (uint8_t i = 0; i < n_keys; i++) {
+        if (window && i >= KEYBOARD_REPORT_KEYS) {
+            send_keyboard_report();
+            del_key(keys[i - KEYBOARD_REPORT_KEYS]);
+        }
+        add_key(keys[i]);
+    }
+    send_keyboard_report();
+    for (uint8_t i = 0; i < n_keys; i++) {
+        del_key(keys[i]);
+    }
+    send_keyboard_report();
+}
+#endif // STENO_ENABLE_HID
+
+static const steno_protocol_t steno_protocols[] = {
+#ifdef STENO_ENABLE_GEMINI
+    [STENO_MODE_GEMINI] = {encode_gemini, send_steno_chord_gemini},
+#endif
+#ifdef STENO_ENABLE_BOLT
+    [STENO_MODE_BOLT] = {encode_bolt, send_steno_chord_bolt},
+#endif
+#ifdef STENO_ENABLE_HID
+    [STENO_MODE_HID] = {encode_gemini, send_steno_chord_hid},
+#endif
+};
+
+static inline const steno_protocol_t *steno_get_protocol(steno_mode_t mode) {
+    if (mode >= sizeof(steno_protocols) / sizeof(steno_protocols[0]) || steno_protocols[mode].encode == NULL) {
+        return NULL;
+    }
+    return &steno_protocols[mode];
 }
-#endif // STENO_ENABLE_BOLT
 
 #ifdef STENO_COMBINEDMAP
 /* Used to look up when pressing the middle row key to combine two consonant or vowel keys */
@@ -132,6 +211,9 @@ void steno_init() {
         eeconfig_init();
     }
     mode = eeprom_read_byte(EECONFIG_STENOMODE);
+    if (steno_get_protocol(mode) == NULL) {
+        mode = STENO_MODE_GEMINI;
+    }
 }
 
 void steno_set_mode(steno_mode_t new_mode) {
@@ -183,6 +265,12 @@ bool process_steno(uint16_t keycode, keyrecord_t *record) {
                 steno_set_mode(STENO_MODE_GEMINI);
             }
             return false;
+
+        case QK_STENO_HID:
+            if (IS_PRESSED(record->event)) {
+                steno_set_mode(STENO_MODE_HID);
+            }
+            return false;
 #endif // STENO_ENABLE_ALL
 
 #ifdef STENO_COMBINEDMAP
@@ -192,23 +280,14 @@ bool process_steno(uint16_t keycode, keyrecord_t *record) {
             return first_result && second_result;
         }
 #endif // STENO_COMBINEDMAP
-        case STN__MIN ... STN__MAX:
+        case STN__MIN ... STN__MAX: {
+            const steno_protocol_t *protocol = steno_get_protocol(mode);
+            if (protocol == NULL) {
+                return false;
+            }
             if (IS_PRESSED(record->event)) {
                 n_pressed_keys++;
-                switch (mode) {
-#ifdef STENO_ENABLE_BOLT
-                    case STENO_MODE_BOLT:
-                        add_bolt_key_to_chord(keycode - QK_STENO);
-                        break;
-#endif // STENO_ENABLE_BOLT
-#ifdef STENO_ENABLE_GEMINI
-                    case STENO_MODE_GEMINI:
-                        add_gemini_key_to_chord(keycode - QK_STENO);
-                        break;
-#endif // STENO_ENABLE_GEMINI
-                    default:
-                        return false;
-                }
+                protocol->encode(keycode - QK_STENO, chord);
                 if (!post_process_steno_user(keycode, record, mode, chord, n_pressed_keys)) {
                     return false;
                 }
@@ -227,23 +306,13 @@ bool process_steno(uint16_t keycode, keyrecord_t *record) {
                     steno_clear_chord();
                     return false;
                 }
-                switch (mode) {
-#if defined(STENO_ENABLE_BOLT) && defined(VIRTSER_ENABLE)
-                    case STENO_MODE_BOLT:
-                        send_steno_chord_bolt();
-                        break;
-#endif // STENO_ENABLE_BOLT && VIRTSER_ENABLE
-#if defined(STENO_ENABLE_GEMINI) && defined(VIRTSER_ENABLE)
-                    case STENO_MODE_GEMINI:
-                        send_steno_chord_gemini();
-                        break;
-#endif // STENO_ENABLE_GEMINI && VIRTSER_ENABLE
-                    default:
-                        break;
+                if (protocol->send) {
+                    protocol->send(chord);
                 }
                 steno_clear_chord();
             }
             break;
+        }
     }
     return false;
 }
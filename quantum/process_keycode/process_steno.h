@@ -21,7 +21,8 @@
 #define BOLT_STROKE_SIZE 4
 #define GEMINI_STROKE_SIZE 6
 
-#ifdef STENO_ENABLE_GEMINI
+// The HID fallback hands chords to the hooks in the GeminiPR layout
+#if defined(STENO_ENABLE_GEMINI) || defined(STENO_ENABLE_HID)
 #    define MAX_STROKE_SIZE GEMINI_STROKE_SIZE
 #else
 #    define MAX_STROKE_SIZE BOLT_STROKE_SIZE
@@ -30,6 +31,7 @@
 typedef enum {
     STENO_MODE_GEMINI,
     STENO_MODE_BOLT,
+    STENO_MODE_HID,
 } steno_mode_t;
 
 bool process_steno(uint16_t keycode, keyrecord_t *record);
@@ -54,6 +54,7 @@ __attribute__((weak)) void qk_ucis_symbol_fallback(void) {
         uint8_t keycode = qk_ucis_state.codes[i];
         register_code(keycode);
         unregister_code(keycode);
+        flush_keyboard_report();
         wait_ms(UNICODE_TYPE_DELAY);
     }
 }
@@ -63,6 +64,7 @@ __attribute__((weak)) void qk_ucis_cancel(void) {}
 void register_ucis(const uint32_t *code_points) {
     for (int i = 0; i < UCIS_MAX_CODE_POINTS && code_points[i]; i++) {
         register_unicode(code_points[i]);
+        flush_keyboard_report();
         wait_ms(UNICODE_TYPE_DELAY);
     }
 }
@@ -96,6 +98,7 @@ bool process_ucis(uint16_t keycode, keyrecord_t *record) {
             for (uint8_t i = 0; i < qk_ucis_state.count; i++) {
                 register_code(KC_BACKSPACE);
                 unregister_code(KC_BACKSPACE);
+                flush_keyboard_report();
                 wait_ms(UNICODE_TYPE_DELAY);
             }
 
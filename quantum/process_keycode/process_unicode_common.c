@@ -81,7 +81,19 @@ void persist_unicode_input_mode(void) {
     eeprom_update_byte(EECONFIG_UNICODEMODE, unicode_config.input_mode);
 }
 
-__attribute__((weak)) void unicode_input_start(void) {
+/* Unicode input is split into a session, which puts the host's lock keys and
+ * the modifiers into a known state and back, and one sequence per code point,
+ * which enters and leaves the host's input method. The default start and finish
+ * functions keep the session open between the code points of a string, so
+ * keymaps that override either of them still get one whole start/finish pair
+ * per code point.
+ */
+
+static bool unicode_string_pending = false; // send_unicode_string() has more code points to type
+static bool unicode_session_open   = false; // Opened by the default unicode_input_start()
+static bool unicode_session_kept   = false; // Left open by the default unicode_input_finish() for the next code point
+
+static void unicode_session_begin(void) {
     unicode_saved_caps_lock = host_keyboard_led_state().caps_lock;
     unicode_saved_num_lock  = host_keyboard_led_state().num_lock;
 
@@ -97,6 +109,30 @@ __attribute__((weak)) void unicode_input_start(void) {
     clear_mods();                    // Unregister mods to start from a clean state
     clear_weak_mods();
 
+    // For increased reliability, use numpad keys for inputting digits
+    if (unicode_config.input_mode == UC_WIN && !unicode_saved_num_lock) {
+        tap_code(KC_NUM_LOCK);
+    }
+}
+
+static void unicode_session_end(void) {
+    switch (unicode_config.input_mode) {
+        case UC_LNX:
+            if (unicode_saved_caps_lock) {
+                tap_code(KC_CAPS_LOCK);
+            }
+            break;
+        case UC_WIN:
+            if (!unicode_saved_num_lock) {
+                tap_code(KC_NUM_LOCK);
+            }
+            break;
+    }
+
+    set_mods(unicode_saved_mods); // Reregister previously set mods
+}
+
+static void unicode_sequence_begin(void) {
     switch (unicode_config.input_mode) {
         case UC_MAC:
             register_code(UNICODE_KEY_MAC);
@@ -105,11 +141,8 @@ __attribute__((weak)) void unicode_input_start(void) {
             tap_code16(UNICODE_KEY_LNX);
             break;
         case UC_WIN:
-            // For increased reliability, use numpad keys for inputting digits
-            if (!unicode_saved_num_lock) {
-                tap_code(KC_NUM_LOCK);
-            }
             register_code(KC_LEFT_ALT);
+            flush_keyboard_report();
             wait_ms(UNICODE_TYPE_DELAY);
             tap_code(KC_KP_PLUS);
             break;
@@ -125,25 +158,20 @@ __attribute__((weak)) void unicode_input_start(void) {
             break;
     }
 
+    flush_keyboard_report();
     wait_ms(UNICODE_TYPE_DELAY);
 }
 
-__attribute__((weak)) void unicode_input_finish(void) {
+static void unicode_sequence_end(void) {
     switch (unicode_config.input_mode) {
         case UC_MAC:
             unregister_code(UNICODE_KEY_MAC);
             break;
         case UC_LNX:
             tap_code(KC_SPACE);
-            if (unicode_saved_caps_lock) {
-                tap_code(KC_CAPS_LOCK);
-            }
             break;
         case UC_WIN:
             unregister_code(KC_LEFT_ALT);
-            if (!unicode_saved_num_lock) {
-                tap_code(KC_NUM_LOCK);
-            }
             break;
         case UC_WINC:
             tap_code(KC_ENTER);
@@ -152,8 +180,37 @@ __attribute__((weak)) void unicode_input_finish(void) {
             tap_code16(KC_ENTER);
             break;
     }
+}
 
-    set_mods(unicode_saved_mods); // Reregister previously set mods
+/* macOS keeps accepting groups of four hex digits for as long as the input
+ * key is held, so a whole string is typed as one sequence there.
+ */
+__attribute__((weak)) void unicode_input_start(void) {
+    if (unicode_session_kept) {
+        unicode_session_kept = false;
+        if (unicode_config.input_mode != UC_MAC) {
+            unicode_sequence_begin();
+        }
+        return;
+    }
+
+    unicode_session_begin();
+    unicode_sequence_begin();
+    unicode_session_open = true;
+}
+
+__attribute__((weak)) void unicode_input_finish(void) {
+    if (unicode_string_pending && unicode_session_open) {
+        if (unicode_config.input_mode != UC_MAC) {
+            unicode_sequence_end();
+        }
+        unicode_session_kept = true;
+        return;
+    }
+
+    unicode_sequence_end();
+    unicode_session_end();
+    unicode_session_open = false;
 }
 
 __attribute__((weak)) void unicode_input_cancel(void) {
@@ -224,13 +281,11 @@ void register_hex32(uint32_t hex) {
     }
 }
 
-void register_unicode(uint32_t code_point) {
-    if (code_point > 0x10FFFF || (code_point > 0xFFFF && unicode_config.input_mode == UC_WIN)) {
-        // Code point out of range, do nothing
-        return;
-    }
+static bool unicode_code_point_supported(uint32_t code_point) {
+    return code_point <= 0x10FFFF && (code_point <= 0xFFFF || unicode_config.input_mode != UC_WIN);
+}
 
-    unicode_input_start();
+static void unicode_type_code_point(uint32_t code_point) {
     if (code_point > 0xFFFF && unicode_config.input_mode == UC_MAC) {
         // Convert code point to UTF-16 surrogate pair on macOS
         code_point -= 0x10000;
@@ -240,22 +295,51 @@ void register_unicode(uint32_t code_point) {
     } else {
         register_hex32(code_point);
     }
+}
+
+void register_unicode(uint32_t code_point) {
+    if (!unicode_code_point_supported(code_point)) {
+        // Code point out of range, do nothing
+        return;
+    }
+
+    unicode_input_start();
+    unicode_type_code_point(code_point);
     unicode_input_finish();
 }
 
+/** Decodes code points from `*str` until one that can be typed in the current input mode, or returns -1 at the end of the string */
+static int32_t next_supported_code_point(const char **str) {
+    while (**str) {
+        int32_t code_point = 0;
+        *str               = decode_utf8(*str, &code_point);
+
+        if (code_point >= 0 && unicode_code_point_supported(code_point)) {
+            return code_point;
+        }
+    }
+    return -1;
+}
+
+/* Types a whole string in one input session, so the lock keys and mods are
+ * only saved and restored once rather than around every code point.
+ */
 void send_unicode_string(const char *str) {
     if (!str) {
         return;
     }
 
-    while (*str) {
-        int32_t code_point = 0;
-        str                = decode_utf8(str, &code_point);
+    int32_t next = next_supported_code_point(&str);
+    while (next >= 0) {
+        const int32_t code_point = next;
+        next                     = next_supported_code_point(&str);
 
-        if (code_point >= 0) {
-            register_unicode(code_point);
-        }
+        unicode_input_start();
+        unicode_type_code_point(code_point);
+        unicode_string_pending = next >= 0;
+        unicode_input_finish();
     }
+    unicode_string_pending = false;
 }
 
 // clang-format off
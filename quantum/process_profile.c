@@ -0,0 +1,110 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "process_profile.h"
+#include "print.h"
+
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#    include <hal.h>
+#    if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+#        define PROFILE_USE_DWT
+#    endif
+#elif defined(__AVR__)
+#    include <util/atomic.h>
+#    include "timer_avr.h"
+extern volatile uint32_t timer_count;
+// The timer0 compare match flag, which stays set until the interrupt that counts the millisecond has run
+#    if defined(__AVR_ATmega32A__)
+#        define PROFILE_TIMER_FLAGS TIFR
+#        define PROFILE_TIMER_MATCH OCF0
+#    elif defined(__AVR_ATtiny85__)
+#        define PROFILE_TIMER_FLAGS TIFR
+#        define PROFILE_TIMER_MATCH OCF0A
+#    else
+#        define PROFILE_TIMER_FLAGS TIFR0
+#        define PROFILE_TIMER_MATCH OCF0A
+#    endif
+#else
+#    include <time.h>
+#endif
+
+static process_profile_t *profile_head = NULL;
+static process_profile_t *profile_tail = NULL;
+
+void process_profile_init(void) {
+#if defined(PROFILE_USE_DWT)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+uint32_t process_profile_read(void) {
+#if defined(PROFILE_USE_DWT)
+    return DWT->CYCCNT;
+#elif defined(PROTOCOL_CHIBIOS)
+#    if PORT_SUPPORTS_RT == TRUE
+    return chSysGetRealtimeCounterX();
+#    else
+    return chVTGetSystemTimeX();
+#    endif
+#elif defined(__AVR__)
+    // timer0 runs in CTC mode, so combine the millisecond count with the raw counter
+    uint32_t count;
+    uint8_t  raw;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        count = timer_count;
+        raw   = TIMER_RAW;
+        if (PROFILE_TIMER_FLAGS & _BV(PROFILE_TIMER_MATCH)) {
+            // The counter wrapped before timer_count could be incremented, read it again to be sure it is past the wrap
+            count++;
+            raw = TIMER_RAW;
+        }
+    }
+    return (count * (TIMER_RAW_TOP + 1) + raw) * TIMER_PRESCALER;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)now.tv_sec * 1000000000UL + (uint32_t)now.tv_nsec;
+#endif
+}
+
+void process_profile_record(process_profile_t *profile, uint32_t start) {
+    uint32_t cycles = process_profile_read() - start;
+
+    if (!profile->registered) {
+        profile->registered = true;
+        if (profile_tail) {
+            profile_tail->next = profile;
+        } else {
+            profile_head = profile;
+        }
+        profile_tail = profile;
+    }
+
+    profile->count++;
+    profile->total += cycles;
+    if (cycles > profile->max) {
+        profile->max = cycles;
+    }
+}
+
+const process_profile_t *process_profile_head(void) {
+    return profile_head;
+}
+
+void process_profile_clear(void) {
+    for (process_profile_t *profile = profile_head; profile; profile = profile->next) {
+        profile->count = 0;
+        profile->total = 0;
+        profile->max   = 0;
+    }
+}
+
+void process_profile_print(void) {
+    print("processor                      calls      total        avg      max\n");
+    for (const process_profile_t *profile = profile_head; profile; profile = profile->next) {
+        xprintf("%-30s %6lu %10lu %10lu %8lu\n", profile->name, (unsigned long)profile->count, (unsigned long)profile->total, (unsigned long)(profile->count ? profile->total / profile->count : 0), (unsigned long)profile->max);
+    }
+}
@@ -0,0 +1,77 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/** \file
+ *
+ * Opt-in cycle counting for the process_record_quantum chain.
+ *
+ * Each processor call wrapped in PROCESS_PROFILE() gets its own statically
+ * allocated entry, which registers itself on first use. With the feature
+ * disabled the macro expands to the bare call.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef PROCESS_PROFILE_ENABLE
+
+/** \brief Accumulated cost of a single processor
+ */
+typedef struct process_profile_t {
+    const char *              name;
+    struct process_profile_t *next;
+    uint32_t                  count;
+    uint32_t                  total;
+    uint32_t                  max;
+    bool                      registered;
+} process_profile_t;
+
+/** \brief Call and time a processor, evaluating to its return value
+ */
+#    define PROCESS_PROFILE(func, ...)                                 \
+        ({                                                             \
+            static process_profile_t _profile = {.name = #func};       \
+            uint32_t                 _start   = process_profile_read(); \
+            bool                     _result  = func(__VA_ARGS__);      \
+            process_profile_record(&_profile, _start);                 \
+            _result;                                                   \
+        })
+
+/** \brief Statically allocated entry for a processor called through a pointer
+ */
+#    define PROCESS_PROFILE_ENTRY(func) (&(process_profile_t){.name = #func})
+
+/** \brief Enable the platform cycle counter
+ */
+void process_profile_init(void);
+
+/** \brief Read the platform cycle counter
+ *
+ * DWT CYCCNT on Cortex-M3 and above, the system tick elsewhere on ChibiOS,
+ * the timer0 count on AVR and nanoseconds on the test platform.
+ */
+uint32_t process_profile_read(void);
+
+/** \brief Accumulate the cycles elapsed since start against the given entry
+ */
+void process_profile_record(process_profile_t *profile, uint32_t start);
+
+/** \brief First registered entry, in order of first use
+ */
+const process_profile_t *process_profile_head(void);
+
+/** \brief Reset all accumulated counters
+ */
+void process_profile_clear(void);
+
+/** \brief Dump all entries to the console
+ */
+void process_profile_print(void);
+
+#else
+
+#    define PROCESS_PROFILE(func, ...) func(__VA_ARGS__)
+
+#endif
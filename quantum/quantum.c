@@ -15,6 +15,7 @@
  */
 
 #include "quantum.h"
+#include "process_profile.h"
 
 #ifdef BLUETOOTH_ENABLE
 #    include "outputselect.h"
@@ -204,7 +205,7 @@ uint16_t get_event_keycode(keyevent_t event, bool update_layer_cache) {
 bool pre_process_record_quantum(keyrecord_t *record) {
     if (!(
 #ifdef COMBO_ENABLE
-            process_combo(get_record_keycode(record, true), record) &&
+            PROCESS_PROFILE(process_combo, get_record_keycode(record, true), record) &&
 #endif
             true)) {
         return false;
@@ -212,131 +213,190 @@ bool pre_process_record_quantum(keyrecord_t *record) {
     return true; // continue processing
 }
 
-/* Get keycode, and then call keyboard function */
-void post_process_record_quantum(keyrecord_t *record) {
-    uint16_t keycode = get_record_keycode(record, false);
-    post_process_record_kb(keycode, record);
-}
-
-/* Core keycode function, hands off handling to other functions,
-    then processes internal quantum keycodes, and then processes
-    ACTIONs.                                                      */
-bool process_record_quantum(keyrecord_t *record) {
-    uint16_t keycode = get_record_keycode(record, true);
-
-    // This is how you use actions here
-    // if (keycode == KC_LEAD) {
-    //   action_t action;
-    //   action.code = ACTION_DEFAULT_LAYER_SET(0);
-    //   process_action(record, action);
-    //   return false;
-    // }
-
-#if defined(SECURE_ENABLE)
-    if (!preprocess_secure(keycode, record)) {
-        return false;
-    }
-#endif
-
-#ifdef VELOCIKEY_ENABLE
-    if (velocikey_enabled() && record->event.pressed) {
-        velocikey_accelerate();
-    }
-#endif
+#define PROCESS_ON_PRESS (1 << 0)
+#define PROCESS_ON_RELEASE (1 << 1)
+#define PROCESS_ON_ANY (PROCESS_ON_PRESS | PROCESS_ON_RELEASE)
 
-#ifdef WPM_ENABLE
-    if (record->event.pressed) {
-        update_wpm(keycode);
-    }
+typedef struct {
+    bool (*process)(uint16_t keycode, keyrecord_t *record);
+    uint16_t min;
+    uint16_t max;
+    uint8_t  events;
+#ifdef PROCESS_PROFILE_ENABLE
+    process_profile_t *profile;
 #endif
+} process_record_handler_t;
 
-#ifdef TAP_DANCE_ENABLE
-    preprocess_tap_dance(keycode, record);
+#ifdef PROCESS_PROFILE_ENABLE
+#    define PROCESS_HANDLER(func, lo, hi, ev) \
+        { .process = func, .min = (lo), .max = (hi), .events = (ev), .profile = PROCESS_PROFILE_ENTRY(func) }
+#else
+#    define PROCESS_HANDLER(func, lo, hi, ev) \
+        { .process = func, .min = (lo), .max = (hi), .events = (ev) }
 #endif
+#define PROCESS_HANDLER_ALWAYS(func) PROCESS_HANDLER(func, 0, UINT16_MAX, PROCESS_ON_ANY)
 
-    if (!(
-#if defined(KEY_LOCK_ENABLE)
-            // Must run first to be able to mask key_up events.
-            process_key_lock(&keycode, record) &&
-#endif
+/* Processors called by process_record_quantum, in order.
+ *
+ * Each entry declares the keycodes and event kinds it can act on, so that it is
+ * not called at all for anything else. Ranges may be wider than what the
+ * processor handles, never narrower. Processors that record, interrupt or give
+ * feedback on arbitrary keys must see everything.
+ */
+static const process_record_handler_t process_record_handlers[] = {
 #if defined(DYNAMIC_MACRO_ENABLE) && !defined(DYNAMIC_MACRO_USER_CALL)
-            // Must run asap to ensure all keypresses are recorded.
-            process_dynamic_macro(keycode, record) &&
+    // Must run asap to ensure all keypresses are recorded.
+    PROCESS_HANDLER_ALWAYS(process_dynamic_macro),
 #endif
 #if defined(AUDIO_ENABLE) && defined(AUDIO_CLICKY)
-            process_clicky(keycode, record) &&
+    PROCESS_HANDLER_ALWAYS(process_clicky),
 #endif
 #ifdef HAPTIC_ENABLE
-            process_haptic(keycode, record) &&
+    PROCESS_HANDLER_ALWAYS(process_haptic),
 #endif
 #if defined(VIA_ENABLE)
-            process_record_via(keycode, record) &&
+    PROCESS_HANDLER_ALWAYS(process_record_via),
 #endif
-            process_record_kb(keycode, record) &&
+    PROCESS_HANDLER_ALWAYS(process_record_kb),
 #if defined(SECURE_ENABLE)
-            process_secure(keycode, record) &&
+    PROCESS_HANDLER_ALWAYS(process_secure),
 #endif
 #if defined(SEQUENCER_ENABLE)
-            process_sequencer(keycode, record) &&
+    PROCESS_HANDLER(process_sequencer, SQ_ON, SEQUENCER_TRACK_MAX, PROCESS_ON_PRESS),
 #endif
 #if defined(MIDI_ENABLE) && defined(MIDI_ADVANCED)
-            process_midi(keycode, record) &&
+    PROCESS_HANDLER(process_midi, MI_ON, MI_BENDU, PROCESS_ON_ANY),
 #endif
 #ifdef AUDIO_ENABLE
-            process_audio(keycode, record) &&
+    PROCESS_HANDLER(process_audio, AU_ON, MUV_DE, PROCESS_ON_PRESS),
 #endif
 #if defined(BACKLIGHT_ENABLE) || defined(LED_MATRIX_ENABLE)
-            process_backlight(keycode, record) &&
+    PROCESS_HANDLER(process_backlight, BL_ON, BL_BRTG, PROCESS_ON_PRESS),
 #endif
 #ifdef STENO_ENABLE
-            process_steno(keycode, record) &&
+    PROCESS_HANDLER_ALWAYS(process_steno),
 #endif
 #if (defined(AUDIO_ENABLE) || (defined(MIDI_ENABLE) && defined(MIDI_BASIC))) && !defined(NO_MUSIC_MODE)
-            process_music(keycode, record) &&
+    PROCESS_HANDLER_ALWAYS(process_music),
 #endif
 #ifdef KEY_OVERRIDE_ENABLE
-            process_key_override(keycode, record) &&
+    PROCESS_HANDLER_ALWAYS(process_key_override),
 #endif
 #ifdef TAP_DANCE_ENABLE
-            process_tap_dance(keycode, record) &&
+    PROCESS_HANDLER_ALWAYS(process_tap_dance),
 #endif
 #ifdef CAPS_WORD_ENABLE
-            process_caps_word(keycode, record) &&
+    PROCESS_HANDLER_ALWAYS(process_caps_word),
 #endif
 #if defined(UNICODE_COMMON_ENABLE)
-            process_unicode_common(keycode, record) &&
+    PROCESS_HANDLER_ALWAYS(process_unicode_common),
 #endif
 #ifdef LEADER_ENABLE
-            process_leader(keycode, record) &&
+    PROCESS_HANDLER_ALWAYS(process_leader),
 #endif
 #ifdef PRINTING_ENABLE
-            process_printer(keycode, record) &&
+    PROCESS_HANDLER_ALWAYS(process_printer),
 #endif
 #ifdef AUTO_SHIFT_ENABLE
-            process_auto_shift(keycode, record) &&
+    PROCESS_HANDLER_ALWAYS(process_auto_shift),
 #endif
 #ifdef DYNAMIC_TAPPING_TERM_ENABLE
-            process_dynamic_tapping_term(keycode, record) &&
+    PROCESS_HANDLER(process_dynamic_tapping_term, DT_PRNT, DT_DOWN, PROCESS_ON_PRESS),
 #endif
 #ifdef SPACE_CADET_ENABLE
-            process_space_cadet(keycode, record) &&
+    PROCESS_HANDLER_ALWAYS(process_space_cadet),
 #endif
 #ifdef MAGIC_KEYCODE_ENABLE
-            process_magic(keycode, record) &&
+    PROCESS_HANDLER(process_magic, MAGIC_SWAP_CONTROL_CAPSLOCK, MAGIC_TOGGLE_ESCAPE_CAPSLOCK, PROCESS_ON_PRESS),
 #endif
 #ifdef GRAVE_ESC_ENABLE
-            process_grave_esc(keycode, record) &&
+    PROCESS_HANDLER(process_grave_esc, QK_GRAVE_ESCAPE, QK_GRAVE_ESCAPE, PROCESS_ON_ANY),
 #endif
 #if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
-            process_rgb(keycode, record) &&
+    PROCESS_HANDLER(process_rgb, RGB_TOG, RGB_MODE_TWINKLE, PROCESS_ON_ANY),
 #endif
 #ifdef JOYSTICK_ENABLE
-            process_joystick(keycode, record) &&
+    PROCESS_HANDLER(process_joystick, JS_BUTTON0, JS_BUTTON_MAX, PROCESS_ON_ANY),
 #endif
 #ifdef PROGRAMMABLE_BUTTON_ENABLE
-            process_programmable_button(keycode, record) &&
+    PROCESS_HANDLER(process_programmable_button, PROGRAMMABLE_BUTTON_MIN, PROGRAMMABLE_BUTTON_MAX, PROCESS_ON_ANY),
 #endif
-            true)) {
+};
+
+static bool process_record_handlers_run(uint16_t keycode, keyrecord_t *record) {
+    const uint8_t event = record->event.pressed ? PROCESS_ON_PRESS : PROCESS_ON_RELEASE;
+
+    for (uint8_t i = 0; i < sizeof(process_record_handlers) / sizeof(process_record_handlers[0]); i++) {
+        const process_record_handler_t *handler = &process_record_handlers[i];
+
+        if (keycode < handler->min || keycode > handler->max || !(handler->events & event)) {
+            continue;
+        }
+
+#ifdef PROCESS_PROFILE_ENABLE
+        uint32_t start  = process_profile_read();
+        bool     result = handler->process(keycode, record);
+        process_profile_record(handler->profile, start);
+#else
+        bool result = handler->process(keycode, record);
+#endif
+        if (!result) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Get keycode, and then call keyboard function */
+void post_process_record_quantum(keyrecord_t *record) {
+    uint16_t keycode = get_record_keycode(record, false);
+    post_process_record_kb(keycode, record);
+}
+
+/* Core keycode function, hands off handling to other functions,
+    then processes internal quantum keycodes, and then processes
+    ACTIONs.                                                      */
+bool process_record_quantum(keyrecord_t *record) {
+    uint16_t keycode = get_record_keycode(record, true);
+
+    // This is how you use actions here
+    // if (keycode == KC_LEAD) {
+    //   action_t action;
+    //   action.code = ACTION_DEFAULT_LAYER_SET(0);
+    //   process_action(record, action);
+    //   return false;
+    // }
+
+#if defined(SECURE_ENABLE)
+    if (!preprocess_secure(keycode, record)) {
+        return false;
+    }
+#endif
+
+#ifdef VELOCIKEY_ENABLE
+    if (velocikey_enabled() && record->event.pressed) {
+        velocikey_accelerate();
+    }
+#endif
+
+#ifdef WPM_ENABLE
+    if (record->event.pressed) {
+        update_wpm(keycode);
+    }
+#endif
+
+#ifdef TAP_DANCE_ENABLE
+    preprocess_tap_dance(keycode, record);
+#endif
+
+#if defined(KEY_LOCK_ENABLE)
+    // Must run first to be able to mask key_up events.
+    if (!PROCESS_PROFILE(process_key_lock, &keycode, record)) {
+        return false;
+    }
+#endif
+
+    if (!process_record_handlers_run(keycode, record)) {
         return false;
     }
 
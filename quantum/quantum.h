@@ -197,6 +197,18 @@ extern layer_state_t layer_state;
 #    include "process_dynamic_macro.h"
 #endif
 
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
+
+#ifdef PROCESS_PROFILE_ENABLE
+#    include "process_profile.h"
+#endif
+
+#ifdef MATRIX_TRACE_ENABLE
+#    include "matrix_trace.h"
+#endif
+
 #ifdef SECURE_ENABLE
 #    include "secure.h"
 #    include "process_secure.h"
@@ -1,5 +1,11 @@
 #pragma once
 
+#include <stdint.h>
+#include <stdbool.h>
+
 void raw_hid_receive(uint8_t *data, uint8_t length);
 
 void raw_hid_send(uint8_t *data, uint8_t length);
+
+// Like raw_hid_send(), but never waits for the host; returns whether the report was queued
+bool raw_hid_try_send(uint8_t *data, uint8_t length);
@@ -4,23 +4,121 @@
 
 typedef HSV (*reactive_splash_f)(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
 
+// Sets min_dist and max_dist so that the effect cannot light an led whose dist from the
+// hit is outside of them, returns false if it cannot light any led anymore
+typedef bool (*reactive_reach_f)(uint16_t tick, uint8_t* min_dist, uint8_t* max_dist);
+
+static RGB reactive_splash_led(uint8_t i, uint8_t start, reactive_splash_f effect_func) {
+    uint8_t count = g_last_hit_tracker.count;
+    HSV     hsv   = rgb_matrix_config.hsv;
+    hsv.v         = 0;
+    for (uint8_t j = start; j < count; j++) {
+        int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+        int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+        uint8_t  dist = sqrt16(dx * dx + dy * dy);
+        uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
+        hsv           = effect_func(hsv, dx, dy, dist, tick);
+    }
+    hsv.v = scale8(hsv.v, rgb_matrix_config.hsv.v);
+    return rgb_matrix_hsv_to_rgb(hsv);
+}
+
 bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
-    uint8_t count = g_last_hit_tracker.count;
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
-        HSV hsv = rgb_matrix_config.hsv;
-        hsv.v   = 0;
-        for (uint8_t j = start; j < count; j++) {
-            int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
-            int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
-            uint8_t  dist = sqrt16(dx * dx + dy * dy);
-            uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
-            hsv           = effect_func(hsv, dx, dy, dist, tick);
+        RGB rgb = reactive_splash_led(i, start, effect_func);
+        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+    }
+    return rgb_matrix_check_finished_leds(led_max);
+}
+
+static void reactive_splash_index_init(reactive_splash_index_t* index) {
+    uint8_t min_x = UINT8_MAX, max_x = 0, min_y = UINT8_MAX, max_y = 0;
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        uint8_t x = g_led_config.point[i].x;
+        uint8_t y = g_led_config.point[i].y;
+        uint8_t k = i;
+        for (; k > 0 && g_led_config.point[index->by_x[k - 1]].x > x; k--) {
+            index->by_x[k] = index->by_x[k - 1];
+        }
+        index->by_x[k] = i;
+
+        min_x = x < min_x ? x : min_x;
+        max_x = x > max_x ? x : max_x;
+        min_y = y < min_y ? y : min_y;
+        max_y = y > max_y ? y : max_y;
+    }
+
+    // dx * dx + dy * dy is truncated to 16 bits before sqrt16, so the dist of far
+    // apart leds can come out small: only skip leds if that never happens
+    uint32_t w       = max_x - min_x;
+    uint32_t h       = max_y - min_y;
+    index->unindexed = w * w + h * h > UINT16_MAX;
+}
+
+// Only marks the leds in [led_min, led_max), the ones drawn in this iteration
+static void reactive_splash_index_mark(reactive_splash_index_t* index, uint8_t start, uint8_t led_min, uint8_t led_max, reactive_reach_f reach_func) {
+    memset(index->lit, index->unindexed ? 0xFF : 0, sizeof(index->lit));
+    if (index->unindexed) {
+        return;
+    }
+
+    uint8_t count = g_last_hit_tracker.count;
+    for (uint8_t j = start; j < count; j++) {
+        uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
+        uint8_t  min_dist, max_dist;
+        if (!reach_func(tick, &min_dist, &max_dist)) {
+            continue;
+        }
+
+        // first led at most max_dist to the left of the hit
+        int16_t hx = g_last_hit_tracker.x[j];
+        int16_t hy = g_last_hit_tracker.y[j];
+        uint8_t lo = 0, hi = DRIVER_LED_TOTAL;
+        while (lo < hi) {
+            uint8_t mid = (lo + hi) / 2;
+            if (g_led_config.point[index->by_x[mid]].x < hx - max_dist) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
         }
-        hsv.v   = scale8(hsv.v, rgb_matrix_config.hsv.v);
-        RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
+
+        for (uint8_t k = lo; k < DRIVER_LED_TOTAL; k++) {
+            uint8_t i  = index->by_x[k];
+            int16_t dx = g_led_config.point[i].x - hx;
+            int16_t dy = g_led_config.point[i].y - hy;
+            if (dx > max_dist) break;
+            if (dy > max_dist || dy < -max_dist || i < led_min || i >= led_max) continue;
+
+            // min_dist <= sqrt16(dist2) <= max_dist, without the square root
+            uint32_t dist2 = dx * dx + dy * dy;
+            if (dist2 < (uint32_t)min_dist * min_dist || dist2 > ((uint32_t)max_dist + 1) * (max_dist + 1) - 1) continue;
+            index->lit[i / 8] |= 1 << (i % 8);
+        }
+    }
+}
+
+// Same output as effect_runner_reactive_splash, but only runs effect_func for the
+// leds that reach_func says a hit can light, the others are simply off.
+// Marks are redone in every iteration, so they always match the hits being drawn.
+bool effect_runner_reactive_splash_indexed(uint8_t start, effect_params_t* params, reactive_reach_f reach_func, reactive_splash_f effect_func) {
+    reactive_splash_index_t* index = RGB_MATRIX_EFFECT_STATE(reactive_splash_index_t);
+    if (params->init && params->iter == 0) {
+        reactive_splash_index_init(index);
+    }
+
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+    reactive_splash_index_mark(index, start, led_min, led_max, reach_func);
+
+    HSV off_hsv = rgb_matrix_config.hsv;
+    off_hsv.v   = 0;
+    RGB off     = rgb_matrix_hsv_to_rgb(off_hsv);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        RGB rgb = index->lit[i / 8] & (1 << (i % 8)) ? reactive_splash_led(i, start, effect_func) : off;
         rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
     }
     return rgb_matrix_check_finished_leds(led_max);
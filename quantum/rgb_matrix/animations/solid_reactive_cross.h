@@ -2,11 +2,11 @@
 #    if defined(ENABLE_RGB_MATRIX_SOLID_REACTIVE_CROSS) || defined(ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTICROSS)
 
 #        ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_CROSS
-RGB_MATRIX_EFFECT(SOLID_REACTIVE_CROSS)
+RGB_MATRIX_EFFECT(SOLID_REACTIVE_CROSS, sizeof(reactive_splash_index_t))
 #        endif
 
 #        ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTICROSS
-RGB_MATRIX_EFFECT(SOLID_REACTIVE_MULTICROSS)
+RGB_MATRIX_EFFECT(SOLID_REACTIVE_MULTICROSS, sizeof(reactive_splash_index_t))
 #        endif
 
 #        ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
@@ -26,15 +26,23 @@ static HSV SOLID_REACTIVE_CROSS_math(HSV hsv, int16_t dx, int16_t dy, uint8_t di
     return hsv;
 }
 
+// tick + dist has to stay below 255
+static bool SOLID_REACTIVE_CROSS_reach(uint16_t tick, uint8_t* min_dist, uint8_t* max_dist) {
+    if (tick > 254) return false;
+    *min_dist = 0;
+    *max_dist = 254 - tick;
+    return true;
+}
+
 #            ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_CROSS
 bool SOLID_REACTIVE_CROSS(effect_params_t* params) {
-    return effect_runner_reactive_splash(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_REACTIVE_CROSS_math);
+    return effect_runner_reactive_splash_indexed(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_REACTIVE_CROSS_reach, &SOLID_REACTIVE_CROSS_math);
 }
 #            endif
 
 #            ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTICROSS
 bool SOLID_REACTIVE_MULTICROSS(effect_params_t* params) {
-    return effect_runner_reactive_splash(0, params, &SOLID_REACTIVE_CROSS_math);
+    return effect_runner_reactive_splash_indexed(0, params, &SOLID_REACTIVE_CROSS_reach, &SOLID_REACTIVE_CROSS_math);
 }
 #            endif
 
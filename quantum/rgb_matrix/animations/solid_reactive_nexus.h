@@ -2,11 +2,11 @@
 #    if defined(ENABLE_RGB_MATRIX_SOLID_REACTIVE_NEXUS) || defined(ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTINEXUS)
 
 #        ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_NEXUS
-RGB_MATRIX_EFFECT(SOLID_REACTIVE_NEXUS)
+RGB_MATRIX_EFFECT(SOLID_REACTIVE_NEXUS, sizeof(reactive_splash_index_t))
 #        endif
 
 #        ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTINEXUS
-RGB_MATRIX_EFFECT(SOLID_REACTIVE_MULTINEXUS)
+RGB_MATRIX_EFFECT(SOLID_REACTIVE_MULTINEXUS, sizeof(reactive_splash_index_t))
 #        endif
 
 #        ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
@@ -24,15 +24,23 @@ static HSV SOLID_REACTIVE_NEXUS_math(HSV hsv, int16_t dx, int16_t dy, uint8_t di
     return hsv;
 }
 
+// tick - dist has to be between 0 and 254, and dist at most 72
+static bool SOLID_REACTIVE_NEXUS_reach(uint16_t tick, uint8_t* min_dist, uint8_t* max_dist) {
+    if (tick > 254 + 72) return false;
+    *min_dist = tick > 254 ? tick - 254 : 0;
+    *max_dist = tick < 72 ? tick : 72;
+    return true;
+}
+
 #            ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_NEXUS
 bool SOLID_REACTIVE_NEXUS(effect_params_t* params) {
-    return effect_runner_reactive_splash(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_REACTIVE_NEXUS_math);
+    return effect_runner_reactive_splash_indexed(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_REACTIVE_NEXUS_reach, &SOLID_REACTIVE_NEXUS_math);
 }
 #            endif
 
 #            ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTINEXUS
 bool SOLID_REACTIVE_MULTINEXUS(effect_params_t* params) {
-    return effect_runner_reactive_splash(0, params, &SOLID_REACTIVE_NEXUS_math);
+    return effect_runner_reactive_splash_indexed(0, params, &SOLID_REACTIVE_NEXUS_reach, &SOLID_REACTIVE_NEXUS_math);
 }
 #            endif
 
@@ -2,11 +2,11 @@
 #    if defined(ENABLE_RGB_MATRIX_SOLID_REACTIVE_WIDE) || defined(ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTIWIDE)
 
 #        ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_WIDE
-RGB_MATRIX_EFFECT(SOLID_REACTIVE_WIDE)
+RGB_MATRIX_EFFECT(SOLID_REACTIVE_WIDE, sizeof(reactive_splash_index_t))
 #        endif
 
 #        ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTIWIDE
-RGB_MATRIX_EFFECT(SOLID_REACTIVE_MULTIWIDE)
+RGB_MATRIX_EFFECT(SOLID_REACTIVE_MULTIWIDE, sizeof(reactive_splash_index_t))
 #        endif
 
 #        ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
@@ -21,15 +21,23 @@ static HSV SOLID_REACTIVE_WIDE_math(HSV hsv, int16_t dx, int16_t dy, uint8_t dis
     return hsv;
 }
 
+// tick + dist * 5 has to stay below 255
+static bool SOLID_REACTIVE_WIDE_reach(uint16_t tick, uint8_t* min_dist, uint8_t* max_dist) {
+    if (tick > 254) return false;
+    *min_dist = 0;
+    *max_dist = (254 - tick) / 5;
+    return true;
+}
+
 #            ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_WIDE
 bool SOLID_REACTIVE_WIDE(effect_params_t* params) {
-    return effect_runner_reactive_splash(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_REACTIVE_WIDE_math);
+    return effect_runner_reactive_splash_indexed(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_REACTIVE_WIDE_reach, &SOLID_REACTIVE_WIDE_math);
 }
 #            endif
 
 #            ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTIWIDE
 bool SOLID_REACTIVE_MULTIWIDE(effect_params_t* params) {
-    return effect_runner_reactive_splash(0, params, &SOLID_REACTIVE_WIDE_math);
+    return effect_runner_reactive_splash_indexed(0, params, &SOLID_REACTIVE_WIDE_reach, &SOLID_REACTIVE_WIDE_math);
 }
 #            endif
 
@@ -2,11 +2,11 @@
 #    if defined(ENABLE_RGB_MATRIX_SOLID_SPLASH) || defined(ENABLE_RGB_MATRIX_SOLID_MULTISPLASH)
 
 #        ifdef ENABLE_RGB_MATRIX_SOLID_SPLASH
-RGB_MATRIX_EFFECT(SOLID_SPLASH)
+RGB_MATRIX_EFFECT(SOLID_SPLASH, sizeof(reactive_splash_index_t))
 #        endif
 
 #        ifdef ENABLE_RGB_MATRIX_SOLID_MULTISPLASH
-RGB_MATRIX_EFFECT(SOLID_MULTISPLASH)
+RGB_MATRIX_EFFECT(SOLID_MULTISPLASH, sizeof(reactive_splash_index_t))
 #        endif
 
 #        ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
@@ -18,15 +18,23 @@ HSV SOLID_SPLASH_math(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t ti
     return hsv;
 }
 
+// tick - dist has to be between 0 and 254
+static bool SOLID_SPLASH_reach(uint16_t tick, uint8_t* min_dist, uint8_t* max_dist) {
+    if (tick > 254 + 255) return false;
+    *min_dist = tick > 254 ? tick - 254 : 0;
+    *max_dist = tick < 255 ? tick : 255;
+    return true;
+}
+
 #            ifdef ENABLE_RGB_MATRIX_SOLID_SPLASH
 bool SOLID_SPLASH(effect_params_t* params) {
-    return effect_runner_reactive_splash(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_SPLASH_math);
+    return effect_runner_reactive_splash_indexed(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_SPLASH_reach, &SOLID_SPLASH_math);
 }
 #            endif
 
 #            ifdef ENABLE_RGB_MATRIX_SOLID_MULTISPLASH
 bool SOLID_MULTISPLASH(effect_params_t* params) {
-    return effect_runner_reactive_splash(0, params, &SOLID_SPLASH_math);
+    return effect_runner_reactive_splash_indexed(0, params, &SOLID_SPLASH_reach, &SOLID_SPLASH_math);
 }
 #            endif
 
@@ -1,5 +1,14 @@
 #if defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP)
-RGB_MATRIX_EFFECT(TYPING_HEATMAP)
+RGB_MATRIX_EFFECT(TYPING_HEATMAP, sizeof(typing_heatmap_state_t))
+#    ifdef RGB_MATRIX_CUSTOM_EFFECT_STATES
+typedef struct {
+    uint8_t heat[MATRIX_ROWS][MATRIX_COLS];
+    // A timer to track the last time we decremented all heatmap values.
+    uint16_t decrease_timer;
+    // Whether we should decrement the heatmap values during the next update.
+    bool decrease_values;
+} typing_heatmap_state_t;
+#    endif // RGB_MATRIX_CUSTOM_EFFECT_STATES
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 #        ifndef RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS
@@ -13,10 +22,13 @@ RGB_MATRIX_EFFECT(TYPING_HEATMAP)
 #        ifndef RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT
 #            define RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT 16
 #        endif
+
 void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
+    typing_heatmap_state_t* state = RGB_MATRIX_EFFECT_STATE(typing_heatmap_state_t);
+
 #        ifdef RGB_MATRIX_TYPING_HEATMAP_SLIM
     // Limit effect to pressed keys
-    g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], 32);
+    state->heat[row][col] = qadd8(state->heat[row][col], 32);
 #        else
     if (g_led_config.matrix_co[row][col] == NO_LED) { // skip as pressed key doesn't have an led position
         return;
@@ -27,7 +39,7 @@ void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
                 continue;
             }
             if (i_row == row && i_col == col) {
-                g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], 32);
+                state->heat[row][col] = qadd8(state->heat[row][col], 32);
             } else {
 #            define LED_DISTANCE(led_a, led_b) sqrt16(((int16_t)(led_a.x - led_b.x) * (int16_t)(led_a.x - led_b.x)) + ((int16_t)(led_a.y - led_b.y) * (int16_t)(led_a.y - led_b.y)))
                 uint8_t distance = LED_DISTANCE(g_led_config.point[g_led_config.matrix_co[row][col]], g_led_config.point[g_led_config.matrix_co[i_row][i_col]]);
@@ -37,7 +49,7 @@ void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
                     if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
                         amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
                     }
-                    g_rgb_frame_buffer[i_row][i_col] = qadd8(g_rgb_frame_buffer[i_row][i_col], amount);
+                    state->heat[i_row][i_col] = qadd8(state->heat[i_row][i_col], amount);
                 }
             }
         }
@@ -45,28 +57,23 @@ void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
 #        endif
 }
 
-// A timer to track the last time we decremented all heatmap values.
-static uint16_t heatmap_decrease_timer;
-// Whether we should decrement the heatmap values during the next update.
-static bool decrease_heatmap_values;
-
 bool TYPING_HEATMAP(effect_params_t* params) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
+    typing_heatmap_state_t* state = RGB_MATRIX_EFFECT_STATE(typing_heatmap_state_t);
 
     if (params->init) {
         rgb_matrix_set_color_all(0, 0, 0);
-        memset(g_rgb_frame_buffer, 0, sizeof g_rgb_frame_buffer);
     }
 
     // The heatmap animation might run in several iterations depending on
     // `RGB_MATRIX_LED_PROCESS_LIMIT`, therefore we only want to update the
     // timer when the animation starts.
     if (params->iter == 0) {
-        decrease_heatmap_values = timer_elapsed(heatmap_decrease_timer) >= RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
+        state->decrease_values = timer_elapsed(state->decrease_timer) >= RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
 
         // Restart the timer if we are going to decrease the heatmap this frame.
-        if (decrease_heatmap_values) {
-            heatmap_decrease_timer = timer_read();
+        if (state->decrease_values) {
+            state->decrease_timer = timer_read();
         }
     }
 
@@ -76,15 +83,15 @@ bool TYPING_HEATMAP(effect_params_t* params) {
         for (uint8_t col = 0; col < MATRIX_COLS && RGB_MATRIX_LED_PROCESS_LIMIT; col++) {
             if (g_led_config.matrix_co[row][col] >= led_min && g_led_config.matrix_co[row][col] < led_max) {
                 count++;
-                uint8_t val = g_rgb_frame_buffer[row][col];
+                uint8_t val = state->heat[row][col];
                 if (!HAS_ANY_FLAGS(g_led_config.flags[g_led_config.matrix_co[row][col]], params->flags)) continue;
 
                 HSV hsv = {170 - qsub8(val, 85), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
                 RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
                 rgb_matrix_set_color(g_led_config.matrix_co[row][col], rgb.r, rgb.g, rgb.b);
 
-                if (decrease_heatmap_values) {
-                    g_rgb_frame_buffer[row][col] = qsub8(val, 1);
+                if (state->decrease_values) {
+                    state->heat[row][col] = qsub8(val, 1);
                 }
             }
         }
@@ -35,12 +35,65 @@ __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
     return hsv_to_rgb(hsv);
 }
 
+// ------------------------------------------
+// -----Begin rgb effect state types---------
+#define RGB_MATRIX_EFFECT(name, ...)
+#define RGB_MATRIX_CUSTOM_EFFECT_STATES
+
+#include "rgb_matrix_effects.inc"
+#ifdef RGB_MATRIX_CUSTOM_KB
+#    include "rgb_matrix_kb.inc"
+#endif
+#ifdef RGB_MATRIX_CUSTOM_USER
+#    include "rgb_matrix_user.inc"
+#endif
+
+#undef RGB_MATRIX_CUSTOM_EFFECT_STATES
+#undef RGB_MATRIX_EFFECT
+// -----End rgb effect state types-----------
+// ------------------------------------------
+
+// ------------------------------------------
+// -----Begin rgb effect arena macros--------
+// One member per effect, as large as the state it declares with
+// RGB_MATRIX_EFFECT(name, size): effects never run at the same time, so the
+// arena only needs to hold the largest state, not all of them
+#define RGB_MATRIX_EFFECT(name, ...) uint8_t name[__VA_ARGS__ + 0];
+typedef union {
+#include "rgb_matrix_effects.inc"
+#ifdef RGB_MATRIX_CUSTOM_KB
+#    include "rgb_matrix_kb.inc"
+#endif
+#ifdef RGB_MATRIX_CUSTOM_USER
+#    include "rgb_matrix_user.inc"
+#endif
+} rgb_effect_arena_t;
+#undef RGB_MATRIX_EFFECT
+
+#define RGB_MATRIX_EFFECT(name, ...) [RGB_MATRIX_##name] = __VA_ARGS__ + 0,
+static const uint16_t PROGMEM rgb_effect_state_size[RGB_MATRIX_EFFECT_MAX] = {
+#include "rgb_matrix_effects.inc"
+#undef RGB_MATRIX_EFFECT
+#if defined(RGB_MATRIX_CUSTOM_KB) || defined(RGB_MATRIX_CUSTOM_USER)
+#    define RGB_MATRIX_EFFECT(name, ...) [RGB_MATRIX_CUSTOM_##name] = __VA_ARGS__ + 0,
+#    ifdef RGB_MATRIX_CUSTOM_KB
+#        include "rgb_matrix_kb.inc"
+#    endif
+#    ifdef RGB_MATRIX_CUSTOM_USER
+#        include "rgb_matrix_user.inc"
+#    endif
+#    undef RGB_MATRIX_EFFECT
+#endif
+};
+// -----End rgb effect arena macros----------
+// ------------------------------------------
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
 // ------------------------------------------
 // -----Begin rgb effect includes macros-----
-#define RGB_MATRIX_EFFECT(name)
+#define RGB_MATRIX_EFFECT(name, ...)
 #define RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 #include "rgb_matrix_effects.inc"
@@ -114,6 +167,8 @@ __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
 rgb_config_t rgb_matrix_config; // TODO: would like to prefix this with g_ for global consistancy, do this in another pr
 uint32_t     g_rgb_timer;
 #ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
+// Kept for custom effects only, the built-in ones keep their state in the arena.
+// The linker drops it when nothing uses it.
 uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #endif // RGB_MATRIX_FRAMEBUFFER_EFFECTS
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -126,6 +181,7 @@ static uint8_t         rgb_last_enable   = UINT8_MAX;
 static uint8_t         rgb_last_effect   = UINT8_MAX;
 static effect_params_t rgb_effect_params = {0, LED_FLAG_ALL, false};
 static rgb_task_states rgb_task_state    = SYNCING;
+static rgb_effect_arena_t rgb_matrix_effect_arena __attribute__((aligned));
 #if RGB_DISABLE_TIMEOUT > 0
 static uint32_t rgb_anykey_timer;
 #endif // RGB_DISABLE_TIMEOUT > 0
@@ -196,6 +252,18 @@ void rgb_matrix_update_pwm_buffers(void) {
     rgb_matrix_driver.flush();
 }
 
+void *rgb_matrix_effect_state(void) {
+    return &rgb_matrix_effect_arena;
+}
+
+uint16_t rgb_matrix_get_effect_arena_size(void) {
+    return sizeof(rgb_matrix_effect_arena);
+}
+
+uint16_t rgb_matrix_get_effect_state_size(uint8_t mode) {
+    return mode < RGB_MATRIX_EFFECT_MAX ? pgm_read_word(&rgb_effect_state_size[mode]) : 0;
+}
+
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     rgb_matrix_driver.set_color(index, red, green, blue);
 }
@@ -348,6 +416,10 @@ static void rgb_task_render(uint8_t effect) {
         rgb_effect_params.flags = rgb_matrix_config.flags;
         rgb_matrix_set_color_all(0, 0, 0);
     }
+    // a new effect starts from a zeroed arena, even if its first frame takes several iterations
+    if (rgb_effect_params.init && rgb_effect_params.iter == 0) {
+        memset(&rgb_matrix_effect_arena, 0, sizeof(rgb_matrix_effect_arena));
+    }
 
     // each effect can opt to do calculations
     // and/or request PWM buffer updates.
@@ -504,6 +576,13 @@ void rgb_matrix_init(void) {
         eeconfig_update_rgb_matrix_default();
     }
     eeconfig_debug_rgb_matrix(); // display current eeprom values
+
+    dprintf("rgb_matrix effect arena: %u bytes\n", rgb_matrix_get_effect_arena_size());
+    for (uint8_t mode = 1; mode < RGB_MATRIX_EFFECT_MAX; mode++) {
+        if (rgb_matrix_get_effect_state_size(mode)) {
+            dprintf("rgb_matrix effect %u state: %u bytes\n", mode, rgb_matrix_get_effect_state_size(mode));
+        }
+    }
 }
 
 void rgb_matrix_set_suspend_state(bool state) {
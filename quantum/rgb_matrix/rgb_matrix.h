@@ -122,6 +122,21 @@ uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
 
+/* State for the running effect, zeroed whenever the effect changes. All
+ * effects share the same arena, so each declares the size of its state as the
+ * second argument of RGB_MATRIX_EFFECT(); asking for more than any enabled
+ * effect declared fails to compile.
+ */
+void *rgb_matrix_effect_state(void);
+#define RGB_MATRIX_EFFECT_STATE(type)                                                                                               \
+    ({                                                                                                                              \
+        _Static_assert(sizeof(type) <= sizeof(rgb_effect_arena_t), "no enabled RGB_MATRIX_EFFECT() declares enough state for " #type); \
+        (type *)rgb_matrix_effect_state();                                                                                          \
+    })
+
+uint16_t rgb_matrix_get_effect_arena_size(void);
+uint16_t rgb_matrix_get_effect_state_size(uint8_t mode);
+
 void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed);
 
 void rgb_matrix_task(void);
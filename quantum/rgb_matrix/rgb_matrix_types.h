@@ -47,6 +47,13 @@ typedef struct PACKED {
     uint8_t  index[LED_HITS_TO_REMEMBER];
     uint16_t tick[LED_HITS_TO_REMEMBER];
 } last_hit_t;
+
+// Effect state of the indexed reactive splash runner
+typedef struct {
+    uint8_t by_x[DRIVER_LED_TOTAL];          // leds sorted by x, built when the effect starts
+    uint8_t lit[(DRIVER_LED_TOTAL + 7) / 8]; // leds within reach of a hit in this iteration
+    bool    unindexed;                       // layout too wide for sqrt16, every led is lit
+} reactive_splash_index_t;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
 typedef enum rgb_task_states { STARTING, RENDERING, FLUSHING, SYNCING } rgb_task_states;
@@ -880,6 +880,8 @@ void rgblight_suspend(void) {
 
 void rgblight_wakeup(void) {
     is_suspended = false;
+    // The LEDs may have been without power, and lost what they were showing
+    rgblight_force_next_frame();
 
     if (pre_suspend_enabled) {
         rgblight_enable_noeeprom();
@@ -900,11 +902,56 @@ __attribute__((weak)) void rgblight_call_driver(LED_TYPE *start_led, uint8_t num
     ws2812_setleds(start_led, num_leds);
 }
 
+static bool                   rgblight_frame_valid = false;
+static rgblight_frame_stats_t rgblight_frame_stats;
+
+void rgblight_force_next_frame(void) {
+    rgblight_frame_valid = false;
+}
+
+void rgblight_get_frame_stats(rgblight_frame_stats_t *stats) {
+    *stats = rgblight_frame_stats;
+}
+
+void rgblight_reset_frame_stats(void) {
+    memset(&rgblight_frame_stats, 0, sizeof(rgblight_frame_stats));
+}
+
 #ifndef RGBLIGHT_CUSTOM_DRIVER
 
+// The frame last handed to the driver, after the LED map and RGBW conversion
+static LED_TYPE rgblight_frame[RGBLED_NUM];
+#    ifdef RGBW
+// The led[] values rgblight_frame was converted from
+static LED_TYPE rgblight_frame_source[RGBLED_NUM];
+#    endif
+static uint8_t rgblight_frame_start;
+static uint8_t rgblight_frame_num_leds;
+
+/*
+ * Updates one LED of the frame from led[], returning whether it changed.
+ * Only changed LEDs go through the RGBW conversion.
+ */
+static bool rgblight_frame_update(uint8_t index, const LED_TYPE *source) {
+#    ifdef RGBW
+    if (memcmp(&rgblight_frame_source[index], source, sizeof(LED_TYPE)) == 0) {
+        return false;
+    }
+    rgblight_frame_source[index] = *source;
+    rgblight_frame[index]        = *source;
+    convert_rgb_to_rgbw(&rgblight_frame[index]);
+#    else
+    if (memcmp(&rgblight_frame[index], source, sizeof(LED_TYPE)) == 0) {
+        return false;
+    }
+    rgblight_frame[index] = *source;
+#    endif
+    return true;
+}
+
 void rgblight_set(void) {
-    LED_TYPE *start_led;
-    uint8_t   num_leds = rgblight_ranges.clipping_num_leds;
+    uint8_t start_pos = rgblight_ranges.clipping_start_pos;
+    uint8_t num_leds  = rgblight_ranges.clipping_num_leds;
 
     if (!rgblight_config.enable) {
         for (uint8_t i = rgblight_ranges.effect_start_pos; i < rgblight_ranges.effect_end_pos; i++) {
@@ -929,22 +976,25 @@ void rgblight_set(void) {
     }
 #    endif
 
+    bool changed = !rgblight_frame_valid || start_pos != rgblight_frame_start || num_leds != rgblight_frame_num_leds;
+    for (uint8_t i = start_pos; i < start_pos + num_leds; i++) {
 #    ifdef RGBLIGHT_LED_MAP
-    LED_TYPE led0[RGBLED_NUM];
-    for (uint8_t i = 0; i < RGBLED_NUM; i++) {
-        led0[i] = led[pgm_read_byte(&led_map[i])];
-    }
-    start_led = led0 + rgblight_ranges.clipping_start_pos;
+        changed |= rgblight_frame_update(i, &led[pgm_read_byte(&led_map[i])]);
 #    else
-    start_led = led + rgblight_ranges.clipping_start_pos;
+        changed |= rgblight_frame_update(i, &led[i]);
 #    endif
+    }
 
-#    ifdef RGBW
-    for (uint8_t i = 0; i < num_leds; i++) {
-        convert_rgb_to_rgbw(&start_led[i]);
+    // Bit-banged drivers block interrupts for the whole strip, so skip identical frames
+    if (!changed) {
+        rgblight_frame_stats.skipped++;
+        return;
     }
-#    endif
-    rgblight_call_driver(start_led, num_leds);
+    rgblight_frame_valid    = true;
+    rgblight_frame_start    = start_pos;
+    rgblight_frame_num_leds = num_leds;
+    rgblight_frame_stats.sent++;
+    rgblight_call_driver(rgblight_frame + start_pos, num_leds);
 }
 #endif
 
@@ -295,6 +295,15 @@ typedef struct _rgblight_ranges_t {
 
 extern rgblight_ranges_t rgblight_ranges;
 
+/*
+ * Number of frames rgblight_set() handed to the driver, and skipped because
+ * they were identical to the last one
+ */
+typedef struct _rgblight_frame_stats_t {
+    uint32_t sent;
+    uint32_t skipped;
+} rgblight_frame_stats_t;
+
 /* === Utility Functions ===*/
 void sethsv(uint8_t hue, uint8_t sat, uint8_t val, LED_TYPE *led1);
 void sethsv_raw(uint8_t hue, uint8_t sat, uint8_t val, LED_TYPE *led1); // without RGBLIGHT_LIMIT_VAL check
@@ -303,6 +312,9 @@ void setrgb(uint8_t r, uint8_t g, uint8_t b, LED_TYPE *led1);
 /* === Low level Functions === */
 void rgblight_set(void);
 void rgblight_set_clipping_range(uint8_t start_pos, uint8_t num_leds);
+void rgblight_force_next_frame(void); // resend the next frame even if unchanged, e.g. after the LEDs lost power
+void rgblight_get_frame_stats(rgblight_frame_stats_t *stats);
+void rgblight_reset_frame_stats(void);
 
 /* === Effects and Animations Functions === */
 /*   effect range setting */
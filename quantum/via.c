@@ -49,6 +49,7 @@
 #include "raw_hid.h"
 #include "dynamic_keymap.h"
 #include "eeprom.h"
+#include "crc.h"
 #include "version.h" // for QMK_BUILDDATE used in EEPROM magic
 #include "via_ensure_keycode.h"
 
@@ -195,6 +196,201 @@ bool process_record_via(uint16_t keycode, keyrecord_t *record) {
     return true;
 }
 
+// Bulk keymap writes stream a range of the dynamic keymap buffer without
+// a round trip per report:
+//   id_dynamic_keymap_bulk_start: offset (2 bytes), size (2 bytes)
+//       reply: status, payload bytes per data packet
+//   id_dynamic_keymap_bulk_data: sequence number (from 0), payload
+//       no reply
+//   id_dynamic_keymap_bulk_end: CRC8 of the whole range, see crc8()
+//       reply: status, CRC8 of the received data, bytes received (2 bytes)
+// Data is written as it arrives, so on a failed transfer the host should
+// send it again.
+//
+// Data packets are collected into a page, which is written once it reaches
+// a page boundary, or when the transfer ends.
+static struct {
+    bool     active;
+    uint8_t  status;
+    uint8_t  sequence;  // sequence number expected in the next data packet
+    uint8_t  crc;       // CRC8 of all data received so far
+    uint16_t remaining; // bytes still to be received
+    uint16_t received;
+    uint16_t offset; // keymap buffer offset of page[0]
+    uint8_t  filled; // bytes in page
+    uint8_t  page[VIA_BULK_PAGE_SIZE];
+} via_bulk;
+
+static void via_bulk_flush(void) {
+    if (via_bulk.filled > 0) {
+        dynamic_keymap_set_buffer(via_bulk.offset, via_bulk.filled, via_bulk.page);
+        via_bulk.offset += via_bulk.filled;
+        via_bulk.filled = 0;
+    }
+}
+
+static uint8_t via_bulk_start(uint16_t offset, uint16_t size) {
+    uint16_t buffer_size = dynamic_keymap_get_buffer_size();
+
+    via_bulk.active = false;
+    if (size == 0 || offset >= buffer_size || size > buffer_size - offset) {
+        return via_bulk_bad_range;
+    }
+
+    via_bulk.active    = true;
+    via_bulk.status    = via_bulk_ok;
+    via_bulk.sequence  = 0;
+    via_bulk.crc       = CRC8_INIT;
+    via_bulk.remaining = size;
+    via_bulk.received  = 0;
+    via_bulk.offset    = offset;
+    via_bulk.filled    = 0;
+    return via_bulk_ok;
+}
+
+// data is the sequence number, followed by the payload
+static void via_bulk_data(const uint8_t *data, uint8_t length) {
+    if (!via_bulk.active || via_bulk.status != via_bulk_ok) {
+        return;
+    }
+    // Everything after a lost packet would land at the wrong offset
+    if (length < 1 || data[0] != via_bulk.sequence) {
+        via_bulk.status = via_bulk_lost_packet;
+        return;
+    }
+    via_bulk.sequence++;
+
+    const uint8_t *payload = &data[1];
+    uint16_t       size    = MIN(length - 1, via_bulk.remaining);
+    via_bulk.crc           = crc8_update(via_bulk.crc, payload, size);
+    via_bulk.remaining -= size;
+    via_bulk.received += size;
+
+    while (size > 0) {
+        // The first page ends at the first page boundary after the start offset
+        uint8_t room  = VIA_BULK_PAGE_SIZE - (via_bulk.offset % VIA_BULK_PAGE_SIZE) - via_bulk.filled;
+        uint8_t chunk = MIN(room, size);
+        memcpy(&via_bulk.page[via_bulk.filled], payload, chunk);
+        via_bulk.filled += chunk;
+        payload += chunk;
+        size -= chunk;
+        if (chunk == room) {
+            via_bulk_flush();
+        }
+    }
+}
+
+// data is the host's CRC8 of the whole transfer, the reply is
+// status, CRC8 of the received data, and the number of bytes received
+static void via_bulk_end(uint8_t *data) {
+    uint8_t status = via_bulk.status;
+
+    via_bulk_flush();
+    if (!via_bulk.active || via_bulk.remaining > 0) {
+        status = via_bulk_lost_packet;
+    } else if (status == via_bulk_ok && via_bulk.crc != data[0]) {
+        status = via_bulk_crc_mismatch;
+    }
+    via_bulk.active = false;
+
+    data[0] = status;
+    data[1] = via_bulk.crc;
+    data[2] = via_bulk.received >> 8;
+    data[3] = via_bulk.received & 0xFF;
+}
+
+// Matrix streaming pushes id_switch_matrix_delta reports while the host keeps
+// setting id_switch_matrix_stream, instead of it polling id_switch_matrix_state:
+//   id_switch_matrix_delta, sequence number, time of the last matrix change (4 bytes),
+//   number of rows (bit 7 set when more changed rows follow in the next report),
+//   then for each row: row index, row state (VIA_MATRIX_ROW_BYTES, big-endian)
+// Rows are only marked as sent once their report is queued, so changes are
+// never lost, and rows that do not fit are sent in the next interval.
+// These reports are unsolicited and can arrive ahead of the reply to any
+// command, so hosts must tell them apart by data[0]. Replies still go out,
+// as raw_hid_send() waits for a streamed report to be read.
+#define VIA_MATRIX_ROW_BYTES ((MATRIX_COLS + 7) / 8)
+#define VIA_MATRIX_STREAM_REPORT_SIZE 32
+#define VIA_MATRIX_STREAM_HEADER_SIZE 7
+
+static struct {
+    bool         active;
+    uint8_t      sequence;
+    uint16_t     last_sent;
+    uint32_t     renewed;
+    matrix_row_t rows[MATRIX_ROWS]; // rows as last sent to the host
+} via_matrix_stream;
+
+static void via_matrix_stream_set(bool enable) {
+    if (enable && !via_matrix_stream.active) {
+        // The host starts out with all keys released
+        memset(via_matrix_stream.rows, 0, sizeof(via_matrix_stream.rows));
+        via_matrix_stream.sequence = 0;
+    }
+    via_matrix_stream.active  = enable;
+    via_matrix_stream.renewed = timer_read32();
+}
+
+void via_matrix_stream_task(void) {
+    if (!via_matrix_stream.active) {
+        return;
+    }
+    if (timer_elapsed32(via_matrix_stream.renewed) > VIA_MATRIX_STREAM_TIMEOUT) {
+        via_matrix_stream.active = false;
+        return;
+    }
+    if (timer_elapsed(via_matrix_stream.last_sent) < VIA_MATRIX_STREAM_INTERVAL) {
+        return;
+    }
+
+    uint8_t      data[VIA_MATRIX_STREAM_REPORT_SIZE] = {0};
+    uint8_t      rows[(VIA_MATRIX_STREAM_REPORT_SIZE - VIA_MATRIX_STREAM_HEADER_SIZE) / (1 + VIA_MATRIX_ROW_BYTES)];
+    matrix_row_t values[sizeof(rows)];
+    uint8_t      count = 0;
+    bool         more  = false;
+    uint8_t     *entry = &data[VIA_MATRIX_STREAM_HEADER_SIZE];
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        matrix_row_t value = matrix_get_row(row);
+        if (value == via_matrix_stream.rows[row]) {
+            continue;
+        }
+        if (count == sizeof(rows)) {
+            more = true;
+            break;
+        }
+        rows[count]   = row;
+        values[count] = value;
+        count++;
+
+        *entry++ = row;
+        for (int8_t shift = (VIA_MATRIX_ROW_BYTES - 1) * 8; shift >= 0; shift -= 8) {
+            *entry++ = (value >> shift) & 0xFF;
+        }
+    }
+    if (count == 0) {
+        return;
+    }
+
+    uint32_t time = last_matrix_activity_time();
+    data[0]       = id_switch_matrix_delta;
+    data[1]       = via_matrix_stream.sequence;
+    data[2]       = (time >> 24) & 0xFF;
+    data[3]       = (time >> 16) & 0xFF;
+    data[4]       = (time >> 8) & 0xFF;
+    data[5]       = time & 0xFF;
+    data[6]       = count | (more ? 0x80 : 0);
+
+    // Without the host reading, the report is retried in the next interval
+    if (raw_hid_try_send(data, sizeof(data))) {
+        for (uint8_t i = 0; i < count; i++) {
+            via_matrix_stream.rows[rows[i]] = values[i];
+        }
+        via_matrix_stream.sequence++;
+        via_matrix_stream.last_sent = timer_read();
+    }
+}
+
 // Keyboard level code can override this to handle custom messages from VIA.
 // See raw_hid_receive() implementation.
 // DO NOT call raw_hid_send() in the override function.
@@ -256,6 +452,12 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
 #endif
                     break;
                 }
+                case id_switch_matrix_stream: {
+                    command_data[1] = via_matrix_stream.active;
+                    command_data[2] = VIA_MATRIX_ROW_BYTES;
+                    command_data[3] = MATRIX_ROWS;
+                    break;
+                }
                 default: {
                     raw_hid_receive_kb(data, length);
                     break;
@@ -270,6 +472,12 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
                     via_set_layout_options(value);
                     break;
                 }
+                case id_switch_matrix_stream: {
+                    via_matrix_stream_set(command_data[1] != 0);
+                    command_data[2] = VIA_MATRIX_ROW_BYTES;
+                    command_data[3] = MATRIX_ROWS;
+                    break;
+                }
                 default: {
                     raw_hid_receive_kb(data, length);
                     break;
@@ -397,6 +605,22 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
             dynamic_keymap_set_buffer(offset, size, &command_data[3]);
             break;
         }
+        case id_dynamic_keymap_bulk_start: {
+            uint16_t offset = (command_data[0] << 8) | command_data[1];
+            uint16_t size   = (command_data[2] << 8) | command_data[3];
+            command_data[0] = via_bulk_start(offset, size);
+            command_data[1] = length - 2; // payload bytes per data packet
+            break;
+        }
+        case id_dynamic_keymap_bulk_data: {
+            via_bulk_data(command_data, length - 1);
+            // Data packets are streamed back to back, without a reply
+            return;
+        }
+        case id_dynamic_keymap_bulk_end: {
+            via_bulk_end(command_data);
+            break;
+        }
 #ifdef ENCODER_MAP_ENABLE
         case id_dynamic_keymap_get_encoder: {
             uint16_t keycode = dynamic_keymap_get_encoder(command_data[0], command_data[1], command_data[2] != 0);
@@ -60,6 +60,35 @@
 // so VIA Configurator can detect compatible firmware.
 #define VIA_PROTOCOL_VERSION 0x000A
 
+// Bulk keymap writes are collected into pages of this many bytes,
+// each written to EEPROM at once.
+#ifndef VIA_BULK_PAGE_SIZE
+#    define VIA_BULK_PAGE_SIZE 32
+#endif
+// Page positions are counted in uint8_t
+#if VIA_BULK_PAGE_SIZE < 1 || VIA_BULK_PAGE_SIZE > 255
+#    error "VIA_BULK_PAGE_SIZE must be between 1 and 255"
+#endif
+
+// Matrix changes are streamed at most once per interval, in milliseconds,
+// which defaults to the polling interval of the raw HID endpoint.
+#ifndef VIA_MATRIX_STREAM_INTERVAL
+#    define VIA_MATRIX_STREAM_INTERVAL 1
+#endif
+
+// Streaming stops unless the host renews it within this many milliseconds.
+#ifndef VIA_MATRIX_STREAM_TIMEOUT
+#    define VIA_MATRIX_STREAM_TIMEOUT 5000
+#endif
+
+// Status returned by id_dynamic_keymap_bulk_start and id_dynamic_keymap_bulk_end
+enum via_bulk_status {
+    via_bulk_ok           = 0x00,
+    via_bulk_bad_range    = 0x01, // the transfer does not fit the dynamic keymap
+    via_bulk_lost_packet  = 0x02, // a packet was missing, out of order, or arrived without a transfer
+    via_bulk_crc_mismatch = 0x03, // all packets arrived, but the data does not match the host's CRC
+};
+
 enum via_command_id {
     id_get_protocol_version                 = 0x01, // always 0x01
     id_get_keyboard_value                   = 0x02,
@@ -82,13 +111,18 @@ enum via_command_id {
     id_dynamic_keymap_set_buffer            = 0x13,
     id_dynamic_keymap_get_encoder           = 0x14,
     id_dynamic_keymap_set_encoder           = 0x15,
+    id_dynamic_keymap_bulk_start            = 0x16,
+    id_dynamic_keymap_bulk_data             = 0x17,
+    id_dynamic_keymap_bulk_end              = 0x18,
+    id_switch_matrix_delta                  = 0x19, // sent unsolicited by the keyboard, see via_matrix_stream_task()
     id_unhandled                            = 0xFF,
 };
 
 enum via_keyboard_value_id {
-    id_uptime              = 0x01, //
-    id_layout_options      = 0x02,
-    id_switch_matrix_state = 0x03
+    id_uptime               = 0x01, //
+    id_layout_options       = 0x02,
+    id_switch_matrix_state  = 0x03,
+    id_switch_matrix_stream = 0x04,
 };
 
 enum via_lighting_value {
@@ -167,3 +201,6 @@ void     via_set_layout_options_kb(uint32_t value);
 
 // Called by QMK core to process VIA-specific keycodes.
 bool process_record_via(uint16_t keycode, keyrecord_t *record);
+
+// Called by QMK core to send matrix changes to the host, when it asked for them.
+void via_matrix_stream_task(void);
@@ -0,0 +1,224 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+extern "C" {
+#include "test_matrix.h"
+
+enum combo_events { JK_COMBO, SD_COMBO, FGH_COMBO, COMBO_LENGTH };
+uint16_t COMBO_LEN = COMBO_LENGTH;
+
+const uint16_t jk_combo[] PROGMEM  = {KC_J, KC_K, COMBO_END};
+const uint16_t sd_combo[] PROGMEM  = {LSFT_T(KC_S), LT(1, KC_D), COMBO_END};
+const uint16_t fgh_combo[] PROGMEM = {KC_F, KC_G, KC_H, COMBO_END};
+
+combo_t key_combos[] = {
+    [JK_COMBO]  = COMBO(jk_combo, KC_ESC),
+    [SD_COMBO]  = COMBO(sd_combo, KC_TAB),
+    [FGH_COMBO] = COMBO(fgh_combo, KC_ENT),
+};
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::Invoke;
+
+// Rollover beyond this many held keys is rare enough on real keyboards to not be worth the run time
+#define FUZZ_MAX_HELD_KEYS 10
+#define FUZZ_EDGES_PER_SEED 500
+#define FUZZ_DEFAULT_SEEDS 100
+// Long enough for every tap-hold, combo, tap dance and auto shift timer to expire
+#define FUZZ_SETTLE_TIME (TAPPING_TERM * 10)
+
+struct FuzzEdge {
+    uint32_t time;
+    uint8_t  row;
+    uint8_t  col;
+    bool     pressed;
+};
+
+/**
+ * @brief Random edge sequences pushed through the real action_exec() path,
+ * checking that every sequence leaves the keyboard in a clean state once all
+ * keys are released and all timers had a chance to expire.
+ *
+ * QMK_FUZZ_SEEDS sets the number of sequences to run, QMK_FUZZ_SEED runs just
+ * the sequence of that seed. The sequence of a failing seed is printed in the
+ * trace format replayed by tests/simulator.
+ */
+class ActionFuzz : public TestFixture {
+   public:
+    void SetUp() override {
+        // clang-format off
+        set_keymap({
+            KeymapKey(0, 0, 0, KC_Q), KeymapKey(0, 1, 0, KC_W), KeymapKey(0, 2, 0, KC_E), KeymapKey(0, 3, 0, KC_R), KeymapKey(0, 4, 0, KC_T),
+            KeymapKey(0, 5, 0, KC_Y), KeymapKey(0, 6, 0, KC_U), KeymapKey(0, 7, 0, KC_I), KeymapKey(0, 8, 0, KC_O), KeymapKey(0, 9, 0, KC_P),
+            KeymapKey(0, 0, 1, LCTL_T(KC_A)), KeymapKey(0, 1, 1, LSFT_T(KC_S)), KeymapKey(0, 2, 1, LT(1, KC_D)), KeymapKey(0, 3, 1, KC_F), KeymapKey(0, 4, 1, KC_G),
+            KeymapKey(0, 5, 1, KC_H), KeymapKey(0, 6, 1, KC_J), KeymapKey(0, 7, 1, KC_K), KeymapKey(0, 8, 1, RALT_T(KC_L)), KeymapKey(0, 9, 1, TD(0)),
+            KeymapKey(0, 0, 2, KC_Z), KeymapKey(0, 1, 2, KC_X), KeymapKey(0, 2, 2, KC_C), KeymapKey(0, 3, 2, KC_V), KeymapKey(0, 4, 2, KC_B),
+            KeymapKey(0, 5, 2, KC_N), KeymapKey(0, 6, 2, KC_M), KeymapKey(0, 7, 2, KC_COMM), KeymapKey(0, 8, 2, KC_DOT), KeymapKey(0, 9, 2, TD(1)),
+            KeymapKey(0, 0, 3, KC_LGUI), KeymapKey(0, 1, 3, KC_LALT), KeymapKey(0, 2, 3, LT(2, KC_SPC)), KeymapKey(0, 3, 3, KC_ENT), KeymapKey(0, 4, 3, MO(1)),
+            KeymapKey(1, 0, 0, KC_1), KeymapKey(1, 1, 0, KC_2), KeymapKey(1, 2, 0, KC_3), KeymapKey(1, 3, 0, KC_4), KeymapKey(1, 4, 0, KC_5),
+            KeymapKey(1, 5, 0, KC_6), KeymapKey(1, 6, 0, KC_7), KeymapKey(1, 7, 0, KC_8), KeymapKey(1, 8, 0, KC_9), KeymapKey(1, 9, 0, KC_0),
+            KeymapKey(2, 0, 0, KC_F1), KeymapKey(2, 1, 0, KC_F2), KeymapKey(2, 2, 0, KC_F3), KeymapKey(2, 3, 0, KC_F4), KeymapKey(2, 4, 0, KC_F5),
+            KeymapKey(2, 5, 0, KC_F6), KeymapKey(2, 6, 0, KC_F7), KeymapKey(2, 7, 0, KC_F8), KeymapKey(2, 8, 0, KC_F9), KeymapKey(2, 9, 0, KC_F10),
+        });
+        // clang-format on
+        for (uint8_t layer = 1; layer <= 2; layer++) {
+            for (uint8_t row = 1; row < 4; row++) {
+                for (uint8_t col = 0; col < (row == 3 ? 5 : 10); col++) {
+                    add_key(KeymapKey(layer, col, row, KC_TRNS));
+                }
+            }
+        }
+        for (uint8_t row = 0; row < 4; row++) {
+            for (uint8_t col = 0; col < (row == 3 ? 5 : 10); col++) {
+                keys.push_back({col, row});
+            }
+        }
+    }
+
+    std::vector<keypos_t> keys;
+
+    /**
+     * @brief Rollover heavy random typing: most gaps are shorter than any of
+     * the timers involved, some run past them.
+     */
+    std::vector<FuzzEdge> generate(uint32_t seed) {
+        std::vector<FuzzEdge> edges;
+        std::vector<keypos_t> held;
+        uint32_t              state = seed * 2654435761u + 1;
+        uint32_t              time  = 0;
+
+        auto random = [&](uint32_t bound) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state % bound;
+        };
+
+        while (edges.size() < FUZZ_EDGES_PER_SEED) {
+            uint32_t chance = random(100);
+            time += chance < 50 ? random(16) : chance < 85 ? random(150) : 150 + random(300);
+
+            bool press = held.empty() || (held.size() < FUZZ_MAX_HELD_KEYS && random(100) < 55);
+            if (press) {
+                keypos_t key;
+                do {
+                    key = keys[random(keys.size())];
+                } while (std::any_of(held.begin(), held.end(), [&](keypos_t h) { return h.row == key.row && h.col == key.col; }));
+                held.push_back(key);
+                edges.push_back({time, key.row, key.col, true});
+            } else {
+                size_t   index = random(held.size());
+                keypos_t key   = held[index];
+                held.erase(held.begin() + index);
+                edges.push_back({time, key.row, key.col, false});
+            }
+        }
+
+        for (keypos_t key : held) {
+            time += random(16);
+            edges.push_back({time, key.row, key.col, false});
+        }
+        return edges;
+    }
+
+    /**
+     * @brief Applies the edges at the times they were generated for, scanning
+     * the matrix once every millisecond.
+     */
+    void replay(const std::vector<FuzzEdge>& edges) {
+        uint32_t now = 0;
+        for (const FuzzEdge& edge : edges) {
+            for (; now < edge.time; now++) {
+                run_one_scan_loop();
+            }
+            if (edge.pressed) {
+                press_key(edge.col, edge.row);
+            } else {
+                release_key(edge.col, edge.row);
+            }
+        }
+        idle_for(FUZZ_SETTLE_TIME);
+    }
+
+    std::string format(const std::vector<FuzzEdge>& edges) {
+        std::ostringstream trace;
+        for (const FuzzEdge& edge : edges) {
+            trace << edge.time << " " << +edge.row << " " << +edge.col << " " << (edge.pressed ? "d" : "u") << "\n";
+        }
+        return trace.str();
+    }
+};
+
+TEST_F(ActionFuzz, RandomRolloverLeavesNothingStuck) {
+    TestDriver        driver;
+    report_keyboard_t last_report = {};
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber()).WillRepeatedly(Invoke([&](report_keyboard_t& report) { last_report = report; }));
+
+    uint32_t first = 1, count = FUZZ_DEFAULT_SEEDS;
+    if (const char* seed = getenv("QMK_FUZZ_SEED")) {
+        first = strtoul(seed, nullptr, 0);
+        count = 1;
+    } else if (const char* seeds = getenv("QMK_FUZZ_SEEDS")) {
+        count = strtoul(seeds, nullptr, 0);
+    }
+
+    uint64_t events = 0, overflows = 0;
+    double   seconds = 0;
+
+    for (uint32_t seed = first; seed < first + count; seed++) {
+        std::vector<FuzzEdge> edges = generate(seed);
+        waiting_buffer_clear_stats();
+
+        auto start = std::chrono::steady_clock::now();
+        replay(edges);
+        seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        events += edges.size();
+
+        waiting_buffer_stats_t stats;
+        waiting_buffer_get_stats(&stats);
+        overflows += stats.overflows;
+
+        report_keyboard_t empty_report = {};
+        bool              clean        = memcmp(&last_report, &empty_report, sizeof(report_keyboard_t)) == 0 && memcmp(keyboard_report, &empty_report, sizeof(report_keyboard_t)) == 0;
+        clean &= get_mods() == 0 && get_weak_mods() == 0 && get_oneshot_mods() == 0;
+        clean &= layer_state == 0;
+
+        EXPECT_TRUE(clean) << "seed " << seed << " left keys, mods or layers active, trace:\n" << format(edges);
+        EXPECT_EQ(stats.overflows, 0) << "seed " << seed << " overflowed the waiting buffer, trace:\n" << format(edges);
+        if (!clean || stats.overflows) {
+            break;
+        }
+        clear_keyboard();
+        layer_clear();
+    }
+
+    std::cout << events << " events in " << seconds * 1000 << "ms, " << (uint64_t)(events / seconds) << " events/s, " << overflows << " waiting buffer overflows" << std::endl;
+}
@@ -0,0 +1,243 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class BatchKeyboardReports : public TestFixture {};
+
+TEST_F(BatchKeyboardReports, single_key_is_reported_as_usual) {
+    TestDriver driver;
+    InSequence s;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(BatchKeyboardReports, keys_pressed_in_the_same_scan_share_a_report) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 0, 1, KC_C);
+
+    set_keymap({key_a, key_b, key_c});
+
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    key_a.press();
+    key_b.press();
+    key_c.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    key_b.release();
+    key_c.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(BatchKeyboardReports, rollover_in_the_same_scan_shares_a_report) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({key_a, key_b});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    key_a.release();
+    key_b.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_b.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(BatchKeyboardReports, tap_in_the_same_scan_is_not_lost) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_hold_key = KeymapKey(0, 0, 0, SFT_T(KC_P));
+    auto       regular_key      = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({mod_tap_hold_key, regular_key});
+
+    EXPECT_NO_REPORT(driver);
+    mod_tap_hold_key.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    /* The tap of P is decided and sent within one event, so it is kept. */
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_REPORT(driver, (KC_A));
+    mod_tap_hold_key.release();
+    regular_key.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    regular_key.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(BatchKeyboardReports, key_pressed_again_in_the_same_scan_is_not_lost) {
+    TestDriver driver;
+    InSequence s;
+    auto       first_key  = KeymapKey(0, 0, 0, KC_A);
+    auto       second_key = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({first_key, second_key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    first_key.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    /* Merging would hide the second press of A from the host. */
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_A));
+    first_key.release();
+    second_key.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    second_key.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(BatchKeyboardReports, key_pressed_before_a_mod_release_in_the_same_scan_keeps_the_mod) {
+    TestDriver driver;
+    InSequence s;
+    auto       regular_key = KeymapKey(0, 0, 0, KC_B);
+    auto       shift_key   = KeymapKey(0, 1, 0, KC_LSFT);
+
+    set_keymap({regular_key, shift_key});
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    shift_key.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    /* B comes first in the matrix, so it is pressed while Shift is still held. */
+    EXPECT_REPORT(driver, (KC_LSFT, KC_B));
+    EXPECT_REPORT(driver, (KC_B));
+    regular_key.press();
+    shift_key.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    regular_key.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(BatchKeyboardReports, replay_after_tapping_term_is_not_batched) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_hold_key = KeymapKey(0, 0, 0, SFT_T(KC_P));
+    auto       regular_key      = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({mod_tap_hold_key, regular_key});
+
+    EXPECT_NO_REPORT(driver);
+    mod_tap_hold_key.press();
+    regular_key.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_A));
+    idle_for(TAPPING_TERM);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    regular_key.release();
+    mod_tap_hold_key.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(BatchKeyboardReports, held_back_report_goes_before_a_mouse_report) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_shift = KeymapKey(0, 0, 0, KC_LSFT);
+    auto       key_btn1  = KeymapKey(0, 1, 0, KC_BTN1);
+
+    set_keymap({key_shift, key_btn1});
+
+    // The click reaches the host shifted
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_CALL(driver, send_mouse_mock(testing::Field(&report_mouse_t::buttons, 1)));
+    key_shift.press();
+    key_btn1.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_CALL(driver, send_mouse_mock(testing::Field(&report_mouse_t::buttons, 0)));
+    key_shift.release();
+    key_btn1.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(BatchKeyboardReports, held_back_report_goes_before_a_consumer_report) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_shift = KeymapKey(0, 0, 0, KC_LSFT);
+    auto       key_volu  = KeymapKey(0, 1, 0, KC_VOLU);
+
+    set_keymap({key_shift, key_volu});
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_CALL(driver, send_consumer_mock(AUDIO_VOL_UP));
+    key_shift.press();
+    key_volu.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_CALL(driver, send_consumer_mock(0));
+    key_shift.release();
+    key_volu.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
@@ -0,0 +1,149 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+class DynamicMacro : public TestFixture {
+   public:
+    void SetUp() override {
+        dynamic_macro_set_speed(100);
+        set_keymap({key_a, key_b, key_c, key_rec, key_stop, key_play});
+    }
+
+    void TearDown() override {
+        dynamic_macro_cancel();
+    }
+
+    // Records: A held for 30ms, a 300ms pause, then a tap of B
+    void record_macro(TestDriver& driver) {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+        tap_key(key_rec);
+        key_a.press();
+        idle_for(30);
+        key_a.release();
+        idle_for(300);
+        tap_key(key_b);
+        tap_key(key_stop);
+        testing::Mock::VerifyAndClearExpectations(&driver);
+    }
+
+    KeymapKey key_a    = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey key_b    = KeymapKey(0, 1, 0, KC_B);
+    KeymapKey key_c    = KeymapKey(0, 2, 0, KC_C);
+    KeymapKey key_rec  = KeymapKey(0, 3, 0, DM_REC1);
+    KeymapKey key_stop = KeymapKey(0, 4, 0, DM_RSTP);
+    KeymapKey key_play = KeymapKey(0, 5, 0, DM_PLY1);
+};
+
+TEST_F(DynamicMacro, PlaybackDoesNotBlockTheKeyboard) {
+    TestDriver driver;
+    record_macro(driver);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_A));
+    tap_key(key_play);
+    EXPECT_TRUE(dynamic_macro_is_playing());
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // Keys pressed while the macro plays are processed right away
+    EXPECT_REPORT(driver, (KC_A, KC_C));
+    key_c.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    key_c.release();
+    idle_for(500);
+    EXPECT_FALSE(dynamic_macro_is_playing());
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(DynamicMacro, PlaybackFollowsRecordedTiming) {
+    TestDriver driver;
+    record_macro(driver);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_A));
+    tap_key(key_play);
+    idle_for(25);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(10);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // Long pauses are stored in 16ms steps, so B may come up to 16ms early
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    idle_for(270);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    }
+    idle_for(50);
+    EXPECT_FALSE(dynamic_macro_is_playing());
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(DynamicMacro, PlaybackSpeedScalesDelays) {
+    TestDriver driver;
+    record_macro(driver);
+    dynamic_macro_set_speed(200);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_A));
+    tap_key(key_play);
+    idle_for(10);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    {
+        InSequence s;
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    }
+    idle_for(160);
+    EXPECT_FALSE(dynamic_macro_is_playing());
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(DynamicMacro, PlayKeyCancelsPlayback) {
+    TestDriver driver;
+    record_macro(driver);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_A));
+    tap_key(key_play);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // The held key is released and the rest of the macro never plays
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_B)).Times(0);
+    tap_key(key_play);
+    EXPECT_FALSE(dynamic_macro_is_playing());
+    idle_for(500);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
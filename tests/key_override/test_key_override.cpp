@@ -0,0 +1,276 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+extern "C" {
+const key_override_t **key_overrides = NULL;
+extern bool            key_override_index_bypass;
+}
+
+// Same as ko_make_basic, whose designated initializers C++ does not accept in this order
+static key_override_t make_basic(uint8_t trigger_mods, uint16_t trigger, uint16_t replacement) {
+    key_override_t override  = {};
+    override.trigger         = trigger;
+    override.trigger_mods    = trigger_mods;
+    override.layers          = ~0;
+    override.suppressed_mods = trigger_mods;
+    override.replacement     = replacement;
+    override.options         = ko_options_default;
+    return override;
+}
+
+class KeyOverride : public TestFixture {
+   public:
+    void TearDown() override {
+        key_overrides             = NULL;
+        key_override_index_bypass = false;
+    }
+
+    // Points key_overrides at the given overrides, followed by the NULL terminator
+    void use_overrides(const std::vector<key_override_t> &list) {
+        overrides = list;
+        pointers.clear();
+        for (auto &override : overrides) {
+            pointers.push_back(&override);
+        }
+        pointers.push_back(NULL);
+        key_overrides = pointers.data();
+        // The vector may reuse the previous list's storage, which the index would take for the same array
+        key_override_index_invalidate();
+    }
+
+    std::vector<key_override_t>         overrides;
+    std::vector<const key_override_t *> pointers;
+
+    KeymapKey key_lsft = KeymapKey(0, 0, 0, KC_LSFT);
+    KeymapKey key_a    = KeymapKey(0, 1, 0, KC_A);
+    KeymapKey key_b    = KeymapKey(0, 2, 0, KC_B);
+};
+
+TEST_F(KeyOverride, ShiftedTriggerSendsReplacement) {
+    TestDriver driver;
+    set_keymap({key_lsft, key_a, key_b});
+    use_overrides({make_basic(MOD_MASK_SHIFT, KC_B, KC_2), make_basic(MOD_MASK_SHIFT, KC_A, KC_1)});
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_lsft.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_REPORT(driver, (KC_1)).Times(1);
+    key_a.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    key_a.release();
+    key_lsft.release();
+    run_one_scan_loop();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(KeyOverride, FirstListedOverrideWins) {
+    TestDriver driver;
+    set_keymap({key_lsft, key_a, key_b});
+    use_overrides({make_basic(MOD_MASK_SHIFT, KC_B, KC_3), make_basic(MOD_MASK_SHIFT, KC_A, KC_1), make_basic(MOD_MASK_SHIFT, KC_A, KC_2)});
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_lsft.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_REPORT(driver, (KC_1)).Times(1);
+    key_a.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    key_a.release();
+    key_lsft.release();
+    run_one_scan_loop();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(KeyOverride, ModifierActivatesOverrideOfHeldKey) {
+    TestDriver driver;
+    set_keymap({key_lsft, key_a, key_b});
+    use_overrides({make_basic(MOD_MASK_SHIFT, KC_B, KC_2), make_basic(MOD_MASK_SHIFT, KC_A, KC_1)});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // The replacement is registered once the key repeat delay has passed
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_1)).Times(1);
+    key_lsft.press();
+    idle_for(510); // KEY_OVERRIDE_REPEAT_DELAY
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    key_a.release();
+    key_lsft.release();
+    run_one_scan_loop();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(KeyOverride, IndexIsRebuiltAfterInvalidation) {
+    TestDriver driver;
+    set_keymap({key_lsft, key_a, key_b});
+    use_overrides({make_basic(MOD_MASK_SHIFT, KC_B, KC_2)});
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    tap_key(key_a);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // Same array, different trigger
+    overrides[0].trigger = KC_A;
+    key_override_index_invalidate();
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_lsft.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_REPORT(driver, (KC_2)).Times(1);
+    key_a.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    key_a.release();
+    key_lsft.release();
+    run_one_scan_loop();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(KeyOverride, OverridesPastIndexSizeAreTried) {
+    TestDriver driver;
+    set_keymap({key_lsft, key_a, key_b});
+
+    std::vector<key_override_t> list;
+    for (uint16_t i = 0; i < 520; i++) {
+        list.push_back(make_basic(MOD_MASK_SHIFT, SAFE_RANGE + i, KC_1));
+    }
+    list.push_back(make_basic(MOD_MASK_SHIFT, KC_A, KC_2));
+    use_overrides(list);
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_lsft.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_REPORT(driver, (KC_2)).Times(1);
+    key_a.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    key_a.release();
+    key_lsft.release();
+    run_one_scan_loop();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(KeyOverride, IndexedOverridesWinOverLaterUnindexedOnes) {
+    TestDriver driver;
+    set_keymap({key_lsft, key_a, key_b});
+
+    std::vector<key_override_t> list;
+    for (uint16_t i = 0; i < 520; i++) {
+        list.push_back(make_basic(MOD_MASK_SHIFT, i == 3 ? KC_A : SAFE_RANGE + i, KC_1));
+    }
+    list.push_back(make_basic(MOD_MASK_SHIFT, KC_A, KC_2));
+    use_overrides(list);
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_lsft.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_REPORT(driver, (KC_1)).Times(1);
+    key_a.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    key_a.release();
+    key_lsft.release();
+    run_one_scan_loop();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(KeyOverride, EventsPerOverrideCountBenchmark) {
+    const int      iterations = 20000;
+    const uint16_t sizes[]    = {10, 100, 500};
+    keyrecord_t    record     = {};
+    record.event.key          = {1, 0};
+
+    // Nanoseconds per event
+    auto time_events = [&]() {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            record.event.pressed = !(i & 1);
+            process_key_override(KC_A, &record);
+        }
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() / iterations;
+    };
+
+    add_mods(MOD_BIT(KC_LSFT));
+    for (uint16_t size : sizes) {
+        // Shifted overrides on custom keycodes: all of them pass the fast mods check, none of them trigger
+        std::vector<key_override_t> list;
+        for (uint16_t i = 0; i < size; i++) {
+            list.push_back(make_basic(MOD_MASK_SHIFT, SAFE_RANGE + i, KC_1));
+        }
+        use_overrides(list);
+
+        key_override_index_bypass = true;
+        auto linear               = time_events();
+        key_override_index_bypass = false;
+        auto indexed              = time_events();
+
+        std::cout << "process_key_override with " << size << " overrides: " << linear << " ns per event linear, " << indexed << " ns indexed" << std::endl;
+        RecordProperty("linear_ns_per_event_" + std::to_string(size), (int)linear);
+        RecordProperty("indexed_ns_per_event_" + std::to_string(size), (int)indexed);
+
+        // Small lists are within timer noise of each other
+        if (size >= 100) {
+            EXPECT_LT(indexed, linear);
+        }
+    }
+    clear_mods();
+}
@@ -0,0 +1,155 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class LatencyTrace : public TestFixture {
+   public:
+    void SetUp() override {
+        latency_trace_clear();
+    }
+};
+
+TEST_F(LatencyTrace, TapIsTracedToHostSend) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    EXPECT_EQ(latency_trace_get_count(), 1);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    EXPECT_EQ(latency_trace_get_count(), 2);
+
+    latency_stats_t stats;
+    latency_trace_get_stats(LATENCY_STAGE_DEBOUNCE, &stats);
+    EXPECT_EQ(stats.count, 2);
+    EXPECT_EQ(stats.max, 0);
+
+    latency_trace_get_stats(LATENCY_STAGE_ACTION_EXEC, &stats);
+    EXPECT_EQ(stats.count, 2);
+
+    latency_trace_get_stats(LATENCY_STAGE_PROCESS_RECORD, &stats);
+    EXPECT_EQ(stats.count, 2);
+
+    latency_trace_get_stats(LATENCY_STAGE_HOST_SEND, &stats);
+    EXPECT_EQ(stats.count, 2);
+    EXPECT_EQ(stats.max, 0);
+
+    // The test matrix has no raw stage, and there is no USB IN callback
+    latency_trace_get_stats(LATENCY_STAGE_RAW_MATRIX, &stats);
+    EXPECT_EQ(stats.count, 0);
+    latency_trace_get_stats(LATENCY_STAGE_USB_IN, &stats);
+    EXPECT_EQ(stats.count, 0);
+
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(LatencyTrace, HoldCapturesTappingTermDelay) {
+    TestDriver driver;
+    auto       mod_tap_key = KeymapKey(0, 0, 0, SFT_T(KC_P));
+
+    set_keymap({mod_tap_key});
+
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    idle_for(TAPPING_TERM);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    EXPECT_EQ(latency_trace_get_count(), 1);
+
+    latency_stats_t stats;
+    latency_trace_get_stats(LATENCY_STAGE_PROCESS_RECORD, &stats);
+    EXPECT_EQ(stats.count, 1);
+    EXPECT_GE(stats.p50, TAPPING_TERM * 1000);
+
+    latency_trace_get_stats(LATENCY_STAGE_HOST_SEND, &stats);
+    EXPECT_EQ(stats.count, 1);
+    EXPECT_GE(stats.p50, TAPPING_TERM * 1000);
+    // Only the millisecond timer is available off ChibiOS
+    EXPECT_EQ(latency_trace_get_resolution(), 1000);
+    EXPECT_EQ(stats.p50 % latency_trace_get_resolution(), 0);
+
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(LatencyTrace, EventWithoutReportExpires) {
+    TestDriver driver;
+    auto       layer_key = KeymapKey(0, 0, 0, MO(1));
+    auto       regular_key = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({layer_key, regular_key, KeymapKey(1, 1, 0, KC_B)});
+
+    EXPECT_NO_REPORT(driver);
+    layer_key.press();
+    run_one_scan_loop();
+    layer_key.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    EXPECT_EQ(latency_trace_get_count(), 0);
+
+    // A new event is not traced until the stale one expires
+    idle_for(LATENCY_TRACE_TIMEOUT);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    EXPECT_EQ(latency_trace_get_count(), 2);
+}
+
+TEST_F(LatencyTrace, PercentilesOverBufferedEvents) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, SFT_T(KC_A));
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_LSFT)).Times(LATENCY_TRACE_BUFFER_SIZE / 2);
+    EXPECT_EMPTY_REPORT(driver).Times(LATENCY_TRACE_BUFFER_SIZE / 2);
+
+    // Each hold is traced as a press reported after the tapping term and an immediate release
+    for (uint8_t i = 0; i < LATENCY_TRACE_BUFFER_SIZE / 2; i++) {
+        key.press();
+        idle_for(TAPPING_TERM + 1);
+        key.release();
+        run_one_scan_loop();
+    }
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    EXPECT_EQ(latency_trace_get_count(), LATENCY_TRACE_BUFFER_SIZE);
+
+    latency_stats_t stats;
+    latency_trace_get_stats(LATENCY_STAGE_HOST_SEND, &stats);
+    EXPECT_EQ(stats.count, LATENCY_TRACE_BUFFER_SIZE);
+    EXPECT_EQ(stats.p50, 0);
+    EXPECT_GE(stats.p99, TAPPING_TERM * 1000);
+    EXPECT_EQ(stats.p99, stats.max);
+}
@@ -0,0 +1,217 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+#include <vector>
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+static std::vector<uint16_t> leader_events;
+static int                   leader_ends = 0;
+static std::vector<uint16_t> dictionary_sequence;
+
+extern "C" {
+const uint16_t PROGMEM leader_d[]       = {KC_D, LEADER_END};
+const uint16_t PROGMEM leader_dd[]      = {KC_D, KC_D, LEADER_END};
+const uint16_t PROGMEM leader_qmk[]     = {KC_Q, KC_M, KC_K, LEADER_END};
+const uint16_t PROGMEM leader_a[]       = {KC_A, LEADER_END};
+const uint16_t PROGMEM leader_abcdefg[] = {KC_A, KC_B, KC_C, KC_D, KC_E, KC_F, KC_G, LEADER_END};
+const uint16_t PROGMEM leader_ab[]      = {KC_A, KC_B, LEADER_END};
+
+// Deliberately out of order, the sequences are sorted when the leader key is first used
+leader_sequence_t leader_sequences[LEADER_SEQUENCE_COUNT] = {
+    LEADER_SEQ(leader_qmk, KC_1),
+    LEADER_SEQ(leader_dd, KC_2),
+    LEADER_SEQ(leader_d, KC_3),
+    LEADER_SEQ_ACTION(leader_abcdefg),
+    LEADER_SEQ_ACTION(leader_a),
+    LEADER_SEQ(leader_ab, KC_4),
+};
+
+void process_leader_event(uint16_t sequence_index) {
+    leader_events.push_back(sequence_index);
+}
+
+void leader_end(void) {
+    leader_ends++;
+}
+
+LEADER_EXTERNS();
+
+// The table is used next to a dictionary, which also knows a prefix of leader_dd
+void matrix_scan_user(void) {
+    LEADER_DICTIONARY() {
+        leading = false;
+        dictionary_sequence.assign(leader_sequence, leader_sequence + leader_sequence_size);
+        SEQ_ONE_KEY(KC_D) {
+            tap_code(KC_6);
+        }
+        SEQ_TWO_KEYS(KC_Q, KC_K) {
+            tap_code(KC_5);
+        }
+        leader_end();
+    }
+}
+}
+
+class Leader : public TestFixture {
+   public:
+    void SetUp() override {
+        leader_events.clear();
+        leader_ends = 0;
+        dictionary_sequence.clear();
+        set_keymap({key_lead, key_a, key_b, key_c, key_d, key_e, key_f, key_g, key_q, key_m, key_k});
+    }
+
+    void type(std::vector<KeymapKey *> keys) {
+        for (auto key : keys) {
+            tap_key(*key);
+        }
+    }
+
+    KeymapKey key_lead = KeymapKey(0, 0, 0, KC_LEAD);
+    KeymapKey key_a    = KeymapKey(0, 1, 0, KC_A);
+    KeymapKey key_b    = KeymapKey(0, 2, 0, KC_B);
+    KeymapKey key_c    = KeymapKey(0, 3, 0, KC_C);
+    KeymapKey key_d    = KeymapKey(0, 4, 0, KC_D);
+    KeymapKey key_e    = KeymapKey(0, 5, 0, KC_E);
+    KeymapKey key_f    = KeymapKey(0, 6, 0, KC_F);
+    KeymapKey key_g    = KeymapKey(0, 7, 0, KC_G);
+    KeymapKey key_q    = KeymapKey(0, 8, 0, KC_Q);
+    KeymapKey key_m    = KeymapKey(0, 9, 0, KC_M);
+    KeymapKey key_k    = KeymapKey(0, 0, 1, KC_K);
+};
+
+TEST_F(Leader, UnambiguousSequenceFiresWithoutTimeout) {
+    TestDriver driver;
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_1));
+        EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    }
+    type({&key_lead, &key_q, &key_m, &key_k});
+    EXPECT_EQ(leader_ends, 1);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // The leader sequence is over, keys are sent again
+    EXPECT_REPORT(driver, (KC_Q));
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    tap_key(key_q);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Leader, PrefixOfLongerSequenceFiresOnTimeout) {
+    TestDriver driver;
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    type({&key_lead, &key_d});
+    idle_for(LEADER_TIMEOUT - 10);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    EXPECT_EQ(leader_ends, 0);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_3));
+        EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    }
+    idle_for(20);
+    EXPECT_EQ(leader_ends, 1);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // The dictionary runs first, but leaves table sequences alone
+    EXPECT_TRUE(dictionary_sequence.empty());
+}
+
+TEST_F(Leader, LongerSequenceFiresOnItsLastKey) {
+    TestDriver driver;
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_2));
+        EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    }
+    type({&key_lead, &key_d, &key_d});
+    EXPECT_EQ(leader_ends, 1);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Leader, SequencesCanBeLongerThanTheKeyBuffer) {
+    TestDriver driver;
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    type({&key_lead, &key_a, &key_b, &key_c, &key_d, &key_e, &key_f, &key_g});
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // Actions are reported with their position in leader_sequences
+    EXPECT_EQ(leader_events, std::vector<uint16_t>{3});
+    EXPECT_EQ(leader_ends, 1);
+}
+
+TEST_F(Leader, ActionPrefixFiresOnTimeout) {
+    TestDriver driver;
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    type({&key_lead, &key_a});
+    idle_for(LEADER_TIMEOUT + 10);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EQ(leader_events, std::vector<uint16_t>{4});
+    EXPECT_EQ(leader_ends, 1);
+}
+
+TEST_F(Leader, UnknownSequenceIsLeftToTheDictionary) {
+    TestDriver driver;
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    type({&key_lead, &key_q, &key_k});
+    idle_for(LEADER_TIMEOUT - 10);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_5));
+        EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    }
+    idle_for(20);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_TRUE(leader_events.empty());
+    EXPECT_EQ(dictionary_sequence, (std::vector<uint16_t>{KC_Q, KC_K}));
+    EXPECT_EQ(leader_ends, 1);
+    EXPECT_FALSE(leading);
+}
+
+TEST_F(Leader, TablePrefixIsLeftToTheDictionaryAfterMoreKeys) {
+    TestDriver driver;
+
+    // Q M starts leader_qmk but is not a sequence of the table by itself
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    type({&key_lead, &key_q, &key_m});
+    idle_for(LEADER_TIMEOUT + 10);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_TRUE(leader_events.empty());
+    EXPECT_EQ(dictionary_sequence, (std::vector<uint16_t>{KC_Q, KC_M}));
+    EXPECT_EQ(leader_ends, 1);
+}
@@ -0,0 +1,30 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "led_matrix.h"
+
+// One LED under each key of the 4x10 test matrix, spread over the usual 224x64 area
+led_config_t g_led_config = {{
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9},
+    {10, 11, 12, 13, 14, 15, 16, 17, 18, 19},
+    {20, 21, 22, 23, 24, 25, 26, 27, 28, 29},
+    {30, 31, 32, 33, 34, 35, 36, 37, 38, 39},
+}, {
+    {0, 0}, {24, 0}, {49, 0}, {74, 0}, {99, 0}, {124, 0}, {149, 0}, {174, 0}, {199, 0}, {224, 0},
+    {0, 21}, {24, 21}, {49, 21}, {74, 21}, {99, 21}, {124, 21}, {149, 21}, {174, 21}, {199, 21}, {224, 21},
+    {0, 42}, {24, 42}, {49, 42}, {74, 42}, {99, 42}, {124, 42}, {149, 42}, {174, 42}, {199, 42}, {224, 42},
+    {0, 64}, {24, 64}, {49, 64}, {74, 64}, {99, 64}, {124, 64}, {149, 64}, {174, 64}, {199, 64}, {224, 64},
+}, {
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+}};
+
+// LED i is wired to PWM register 0x24 + i of the only driver
+const is31_led PROGMEM g_is31_leds[DRIVER_LED_TOTAL] = {
+    {0, 0x24}, {0, 0x25}, {0, 0x26}, {0, 0x27}, {0, 0x28}, {0, 0x29}, {0, 0x2A}, {0, 0x2B}, {0, 0x2C}, {0, 0x2D},
+    {0, 0x2E}, {0, 0x2F}, {0, 0x30}, {0, 0x31}, {0, 0x32}, {0, 0x33}, {0, 0x34}, {0, 0x35}, {0, 0x36}, {0, 0x37},
+    {0, 0x38}, {0, 0x39}, {0, 0x3A}, {0, 0x3B}, {0, 0x3C}, {0, 0x3D}, {0, 0x3E}, {0, 0x3F}, {0, 0x40}, {0, 0x41},
+    {0, 0x42}, {0, 0x43}, {0, 0x44}, {0, 0x45}, {0, 0x46}, {0, 0x47}, {0, 0x48}, {0, 0x49}, {0, 0x4A}, {0, 0x4B},
+};
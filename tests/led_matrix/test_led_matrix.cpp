@@ -0,0 +1,160 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <iostream>
+
+#include "test_common.hpp"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "led_matrix.h"
+#include "led_tables.h"
+#include "i2c_master.h"
+#include "lib/lib8tion/lib8tion.h"
+
+extern uint8_t           g_pwm_buffer[LED_DRIVER_COUNT][144];
+extern const led_point_t k_led_matrix_center;
+}
+
+class LedMatrix : public TestFixture {
+   public:
+    TestDriver driver;
+
+    void SetUp() override {
+        led_matrix_enable_noeeprom();
+        led_matrix_set_flags_noeeprom(LED_FLAG_ALL);
+        led_matrix_set_val_noeeprom(UINT8_MAX);
+        led_matrix_set_speed_noeeprom(UINT8_MAX / 2);
+        led_matrix_mode_noeeprom(LED_MATRIX_SOLID);
+        idle_for(100);
+    }
+
+    // Bytes sent to the LED driver in one second, once the first frame of the mode is out
+    uint32_t bus_bytes_per_second(uint8_t mode, const char *name) {
+        led_matrix_mode_noeeprom(mode);
+        idle_for(100);
+        i2c_test_bytes = 0;
+        idle_for(1000);
+        std::cout << name << ": " << i2c_test_bytes << " I2C bytes/s" << std::endl;
+        return i2c_test_bytes;
+    }
+
+    // What the driver was last given for an LED, LED i being on PWM register 0x24 + i
+    uint8_t pwm(uint8_t i) {
+        return g_pwm_buffer[0][i];
+    }
+
+    uint8_t cie(uint8_t value) {
+        return pgm_read_byte(&CIE1931_CURVE[value]);
+    }
+};
+
+TEST_F(LedMatrix, UnchangedFramesAreNotSent) {
+    EXPECT_EQ(bus_bytes_per_second(LED_MATRIX_SOLID, "solid"), 0);
+    EXPECT_EQ(bus_bytes_per_second(LED_MATRIX_SOLID_REACTIVE_SIMPLE, "solid reactive simple, no keys hit"), 0);
+
+    // An animation stands still at speed 0
+    led_matrix_set_speed_noeeprom(0);
+    EXPECT_EQ(bus_bytes_per_second(LED_MATRIX_BAND_PINWHEEL, "band pinwheel, speed 0"), 0);
+
+    led_matrix_set_speed_noeeprom(UINT8_MAX / 2);
+    EXPECT_GT(bus_bytes_per_second(LED_MATRIX_BREATHING, "breathing"), 0);
+    EXPECT_GT(bus_bytes_per_second(LED_MATRIX_BAND_PINWHEEL, "band pinwheel"), 0);
+}
+
+TEST_F(LedMatrix, FullFrameIsResentAfterWakeup) {
+    i2c_test_bytes = 0;
+    idle_for(100);
+    EXPECT_EQ(i2c_test_bytes, 0);
+
+    // The LEDs may have lost power while suspended
+    led_matrix_set_suspend_state(true);
+    led_matrix_set_suspend_state(false);
+    idle_for(100);
+    EXPECT_GT(i2c_test_bytes, 0);
+
+    i2c_test_bytes = 0;
+    idle_for(100);
+    EXPECT_EQ(i2c_test_bytes, 0);
+}
+
+TEST_F(LedMatrix, FullFrameIsResentAfterInit) {
+    // The driver is reset by init, so the frame has to go out again
+    led_matrix_init();
+    i2c_test_bytes = 0;
+    idle_for(100);
+    EXPECT_GT(i2c_test_bytes, 0);
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        EXPECT_EQ(pwm(i), cie(led_matrix_get_val())) << "LED " << (int)i;
+    }
+}
+
+TEST_F(LedMatrix, ChangedFramesAreSent) {
+    EXPECT_EQ(pwm(0), cie(UINT8_MAX));
+
+    i2c_test_bytes = 0;
+    led_matrix_set_val_noeeprom(64);
+    idle_for(100);
+    EXPECT_GT(i2c_test_bytes, 0);
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        EXPECT_EQ(pwm(i), cie(64)) << "LED " << (int)i;
+    }
+
+    // Only the modifier LEDs stay lit
+    i2c_test_bytes = 0;
+    led_matrix_set_flags_noeeprom(LED_FLAG_MODIFIER);
+    idle_for(100);
+    EXPECT_GT(i2c_test_bytes, 0);
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        EXPECT_EQ(pwm(i), g_led_config.flags[i] == LED_FLAG_MODIFIER ? cie(64) : 0) << "LED " << (int)i;
+    }
+}
+
+TEST_F(LedMatrix, PolarEffectsMatchTheirGeometry) {
+    // At speed 0 the effect time stays 0, so every frame is the same
+    led_matrix_set_speed_noeeprom(0);
+
+    for (uint8_t val : {(uint8_t)UINT8_MAX, (uint8_t)150}) {
+        led_matrix_set_val_noeeprom(val);
+
+        led_matrix_mode_noeeprom(LED_MATRIX_BAND_PINWHEEL);
+        idle_for(100);
+        for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+            int16_t dx = g_led_config.point[i].x - k_led_matrix_center.x;
+            int16_t dy = g_led_config.point[i].y - k_led_matrix_center.y;
+            EXPECT_EQ(pwm(i), cie(scale8(val - atan2_8(dy, dx) * 3, val))) << "LED " << (int)i;
+        }
+
+        led_matrix_mode_noeeprom(LED_MATRIX_BAND_SPIRAL);
+        idle_for(100);
+        for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+            int16_t dx   = g_led_config.point[i].x - k_led_matrix_center.x;
+            int16_t dy   = g_led_config.point[i].y - k_led_matrix_center.y;
+            uint8_t dist = sqrt16(dx * dx + dy * dy);
+            EXPECT_EQ(pwm(i), cie(scale8(val + dist - atan2_8(dy, dx), val))) << "LED " << (int)i;
+        }
+
+        led_matrix_mode_noeeprom(LED_MATRIX_CYCLE_OUT_IN);
+        idle_for(100);
+        for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+            int16_t dx   = g_led_config.point[i].x - k_led_matrix_center.x;
+            int16_t dy   = g_led_config.point[i].y - k_led_matrix_center.y;
+            uint8_t dist = sqrt16(dx * dx + dy * dy);
+            EXPECT_EQ(pwm(i), cie(scale8(3 * dist / 2, val))) << "LED " << (int)i;
+        }
+    }
+}
@@ -0,0 +1,108 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+#include <vector>
+
+using testing::_;
+using testing::AnyNumber;
+
+class MatrixTrace : public TestFixture {
+   public:
+    void SetUp() override {
+        matrix_trace_clear();
+    }
+
+    std::vector<uint8_t> read_trace(uint16_t length = MATRIX_TRACE_BUFFER_SIZE) {
+        std::vector<uint8_t> data(length);
+        data.resize(matrix_trace_read(data.data(), length));
+        return data;
+    }
+};
+
+TEST_F(MatrixTrace, EdgesAreRecordedWithTimeSinceThePreviousEdge) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 3, 2, KC_B);
+
+    set_keymap({key_a, key_b});
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    key_a.press();
+    run_one_scan_loop();
+    idle_for(9);
+    key_a.release();
+    run_one_scan_loop();
+    EXPECT_EQ(read_trace(), (std::vector<uint8_t>{0x00, 0x80 | 0, 10, 0}));
+
+    // Gaps of 128ms and more take more than one byte
+    idle_for(299);
+    key_b.press();
+    run_one_scan_loop();
+    key_b.release();
+    run_one_scan_loop();
+    EXPECT_EQ(read_trace(), (std::vector<uint8_t>{0xAC, 0x02, 0x80 | 23, 1, 23}));
+    EXPECT_EQ(matrix_trace_available(), 0);
+}
+
+TEST_F(MatrixTrace, ReadOnlyCopiesWholeEdges) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({key});
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    idle_for(200);
+    key.press();
+    run_one_scan_loop();
+    key.release();
+    run_one_scan_loop();
+    EXPECT_EQ(matrix_trace_available(), 5);
+
+    EXPECT_EQ(read_trace(2), (std::vector<uint8_t>{}));
+    EXPECT_EQ(read_trace(4), (std::vector<uint8_t>{0xC8, 0x01, 0x80 | 1}));
+    EXPECT_EQ(read_trace(4), (std::vector<uint8_t>{1, 1}));
+}
+
+TEST_F(MatrixTrace, EdgesAreDroppedWhenTheBufferIsFull) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 2, 1, KC_A);
+
+    set_keymap({key});
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    // Only edges with room for the longest possible encoding are recorded
+    for (int i = 0; i < 4; i++) {
+        tap_key(key);
+    }
+    EXPECT_EQ(matrix_trace_available(), 12);
+    EXPECT_EQ(matrix_trace_get_dropped(), 2);
+
+    // The time of the next edge is still relative to the last recorded one
+    read_trace();
+    key.press();
+    run_one_scan_loop();
+    EXPECT_EQ(read_trace(), (std::vector<uint8_t>{3, 0x80 | 12}));
+
+    matrix_trace_clear();
+    EXPECT_EQ(matrix_trace_get_dropped(), 0);
+    key.release();
+    run_one_scan_loop();
+}
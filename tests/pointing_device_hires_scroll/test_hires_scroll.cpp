@@ -0,0 +1,104 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+#include "pointing_device.h"
+
+class HiresScroll : public TestFixture {
+   public:
+    void SetUp() override {
+        host_mouse_set_resolution_multiplier(0);
+    }
+};
+
+TEST_F(HiresScroll, IsOffUntilTheHostEnablesIt) {
+    TestDriver driver;
+
+    EXPECT_EQ(pointing_device_get_hires_scroll_resolution(), 1);
+    EXPECT_EQ(pointing_device_get_hires_hscroll_resolution(), 1);
+}
+
+TEST_F(HiresScroll, FollowsTheFeatureReport) {
+    TestDriver driver;
+
+    /* Vertical multiplier only */
+    host_mouse_set_resolution_multiplier(0x01);
+    EXPECT_EQ(pointing_device_get_hires_scroll_resolution(), POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER);
+    EXPECT_EQ(pointing_device_get_hires_hscroll_resolution(), 1);
+
+    /* Horizontal multiplier only */
+    host_mouse_set_resolution_multiplier(0x04);
+    EXPECT_EQ(pointing_device_get_hires_scroll_resolution(), 1);
+    EXPECT_EQ(pointing_device_get_hires_hscroll_resolution(), POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER);
+
+    host_mouse_set_resolution_multiplier(0x05);
+    EXPECT_EQ(pointing_device_get_hires_scroll_resolution(), POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER);
+    EXPECT_EQ(pointing_device_get_hires_hscroll_resolution(), POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER);
+}
+
+TEST_F(HiresScroll, IsOffAgainAfterAUsbReset) {
+    TestDriver driver;
+
+    host_mouse_set_resolution_multiplier(0x05);
+    /* What the USB reset handlers do */
+    host_mouse_set_resolution_multiplier(0);
+    EXPECT_EQ(pointing_device_get_hires_scroll_resolution(), 1);
+    EXPECT_EQ(pointing_device_get_hires_hscroll_resolution(), 1);
+}
+
+TEST_F(HiresScroll, SetFeatureReportSelectsTheMultiplier) {
+    TestDriver driver;
+#ifdef MOUSE_SHARED_EP
+    const uint8_t both[] = {REPORT_ID_MOUSE, 0x05};
+#else
+    const uint8_t both[] = {0x05};
+#endif
+
+    host_mouse_set_feature_report(both, sizeof(both));
+    EXPECT_EQ(pointing_device_get_hires_scroll_resolution(), POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER);
+    EXPECT_EQ(pointing_device_get_hires_hscroll_resolution(), POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER);
+
+    /* Short reports are ignored */
+    host_mouse_set_feature_report(both, sizeof(both) - 1);
+    EXPECT_EQ(host_mouse_resolution_multiplier(), 0x05);
+}
+
+#ifdef MOUSE_SHARED_EP
+TEST_F(HiresScroll, SetFeatureReportForAnotherReportIsIgnored) {
+    TestDriver driver;
+    const uint8_t other[] = {REPORT_ID_MOUSE + 1, 0x05};
+
+    host_mouse_set_feature_report(other, sizeof(other));
+    EXPECT_EQ(host_mouse_resolution_multiplier(), 0);
+}
+#endif
+
+TEST_F(HiresScroll, GetFeatureReportReadsBackTheMultiplier) {
+    TestDriver driver;
+    uint8_t    report[MOUSE_FEATURE_REPORT_SIZE];
+
+    EXPECT_EQ(host_mouse_get_feature_report(report), MOUSE_FEATURE_REPORT_SIZE);
+    EXPECT_EQ(report[MOUSE_FEATURE_REPORT_SIZE - 1], 0);
+#ifdef MOUSE_SHARED_EP
+    EXPECT_EQ(report[0], REPORT_ID_MOUSE);
+#endif
+
+    /* The host reads back what it wrote */
+    host_mouse_set_resolution_multiplier(0x04);
+    EXPECT_EQ(host_mouse_get_feature_report(report), MOUSE_FEATURE_REPORT_SIZE);
+    EXPECT_EQ(report[MOUSE_FEATURE_REPORT_SIZE - 1], 0x04);
+}
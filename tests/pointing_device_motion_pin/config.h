@@ -0,0 +1,34 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "test_common.h"
+
+#define POINTING_DEVICE_MOTION_PIN 0
+#define POINTING_DEVICE_TASK_THROTTLE_MS 5
+
+// The test platform has no GPIO, the tests drive the motion pin
+#define setPinInputHigh(pin)
+#define readPin(pin) motion_pin_read(pin)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+int motion_pin_read(int pin);
+#ifdef __cplusplus
+}
+#endif
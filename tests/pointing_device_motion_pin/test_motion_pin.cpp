@@ -0,0 +1,113 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+#include "pointing_device.h"
+
+#include <vector>
+
+using testing::_;
+using testing::AnyNumber;
+using testing::Invoke;
+
+static bool           motion_pin_active = false;
+static report_mouse_t sensor_motion     = {};
+static uint16_t       sensor_reads      = 0;
+
+extern "C" {
+// The motion pin is active low
+int motion_pin_read(int pin) {
+    return !motion_pin_active;
+}
+
+report_mouse_t pointing_device_driver_get_report(report_mouse_t mouse_report) {
+    sensor_reads++;
+    mouse_report.x = sensor_motion.x;
+    mouse_report.y = sensor_motion.y;
+    return mouse_report;
+}
+}
+
+class MotionPin : public TestFixture {
+   public:
+    void SetUp() override {
+        motion_pin_active = false;
+        sensor_motion     = {};
+        sensor_reads      = 0;
+    }
+
+    /** Reports the sensor's motion on each of `reads` scans, then lets every report go out */
+    void move(mouse_xy_report_t x, mouse_xy_report_t y, uint16_t reads) {
+        sensor_motion.x   = x;
+        sensor_motion.y   = y;
+        motion_pin_active = true;
+        while (sensor_reads < reads) {
+            run_one_scan_loop();
+        }
+        motion_pin_active = false;
+        idle_for(POINTING_DEVICE_TASK_THROTTLE_MS * 10);
+    }
+};
+
+TEST_F(MotionPin, ReadsBetweenReportsAreSummed) {
+    TestDriver                  driver;
+    std::vector<report_mouse_t> reports;
+
+    EXPECT_CALL(driver, send_mouse_mock(_)).Times(AnyNumber()).WillRepeatedly(Invoke([&](report_mouse_t& report) { reports.push_back(report); }));
+    move(3, -2, 20);
+
+    int32_t x = 0, y = 0;
+    for (auto& report : reports) {
+        x += report.x;
+        y += report.y;
+    }
+    EXPECT_EQ(x, 3 * 20);
+    EXPECT_EQ(y, -2 * 20);
+    // One report per POINTING_DEVICE_TASK_THROTTLE_MS, not one per read
+    EXPECT_LE(reports.size(), 20 / POINTING_DEVICE_TASK_THROTTLE_MS + 1);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(MotionPin, MotionPastTheReportRangeIsCarriedOver) {
+    TestDriver                  driver;
+    std::vector<report_mouse_t> reports;
+
+    EXPECT_CALL(driver, send_mouse_mock(_)).Times(AnyNumber()).WillRepeatedly(Invoke([&](report_mouse_t& report) { reports.push_back(report); }));
+    // 200 counts per report, more than fits into one
+    move(40, -40, 10);
+
+    int32_t x = 0, y = 0;
+    for (auto& report : reports) {
+        EXPECT_LE(report.x, XY_REPORT_MAX);
+        EXPECT_GE(report.y, XY_REPORT_MIN);
+        x += report.x;
+        y += report.y;
+    }
+    EXPECT_EQ(x, 40 * 10);
+    EXPECT_EQ(y, -40 * 10);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(MotionPin, SensorIsOnlyReadWhileThePinIsActive) {
+    TestDriver driver;
+
+    EXPECT_CALL(driver, send_mouse_mock(_)).Times(0);
+    sensor_motion.x = 10;
+    idle_for(POINTING_DEVICE_TASK_THROTTLE_MS * 10);
+    EXPECT_EQ(sensor_reads, 0);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
@@ -0,0 +1,161 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+namespace {
+
+const process_profile_t *find_profile(const char *name) {
+    for (const process_profile_t *profile = process_profile_head(); profile; profile = profile->next) {
+        if (strcmp(profile->name, name) == 0) {
+            return profile;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+extern "C" {
+const key_override_t **key_overrides = (const key_override_t *[]){NULL};
+qk_tap_dance_action_t  tap_dance_actions[1];
+combo_t                key_combos[1];
+uint16_t               COMBO_LEN           = 0;
+}
+
+extern "C" bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    return keycode != SAFE_RANGE;
+}
+
+class ProcessProfile : public TestFixture {
+   public:
+    void SetUp() override {
+        process_profile_clear();
+    }
+};
+
+TEST_F(ProcessProfile, ProcessorsAreCountedPerEvent) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    const process_profile_t *record_kb = find_profile("process_record_kb");
+    ASSERT_NE(record_kb, nullptr);
+    EXPECT_EQ(record_kb->count, 2);
+    EXPECT_LE(record_kb->max, record_kb->total);
+
+    const process_profile_t *space_cadet = find_profile("process_space_cadet");
+    ASSERT_NE(space_cadet, nullptr);
+    EXPECT_EQ(space_cadet->count, 2);
+
+    const process_profile_t *key_override = find_profile("process_key_override");
+    ASSERT_NE(key_override, nullptr);
+    EXPECT_EQ(key_override->count, 2);
+}
+
+TEST_F(ProcessProfile, ProcessorsOutsideTheirRangeAreSkipped) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    const process_profile_t *grave_esc = find_profile("process_grave_esc");
+    EXPECT_TRUE(grave_esc == nullptr || grave_esc->count == 0);
+}
+
+TEST_F(ProcessProfile, ProcessorsInsideTheirRangeAreCalled) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, QK_GRAVE_ESCAPE);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_ESC));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    const process_profile_t *grave_esc = find_profile("process_grave_esc");
+    ASSERT_NE(grave_esc, nullptr);
+    EXPECT_EQ(grave_esc->count, 2);
+}
+
+TEST_F(ProcessProfile, PressOnlyProcessorsSkipReleases) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, MAGIC_TOGGLE_GUI);
+
+    set_keymap({key});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key);
+    tap_key(key);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    const process_profile_t *magic = find_profile("process_magic");
+    ASSERT_NE(magic, nullptr);
+    EXPECT_EQ(magic->count, 2);
+}
+
+TEST_F(ProcessProfile, HandledKeycodeStopsTheChain) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, SAFE_RANGE);
+
+    set_keymap({key});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // process_record_user consumes the keycode, so later processors are not reached
+    EXPECT_EQ(find_profile("process_record_kb")->count, 2);
+    const process_profile_t *grave_esc = find_profile("process_grave_esc");
+    EXPECT_TRUE(grave_esc == nullptr || grave_esc->count == 0);
+}
+
+TEST_F(ProcessProfile, ClearResetsCounters) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    process_profile_clear();
+    for (const process_profile_t *profile = process_profile_head(); profile; profile = profile->next) {
+        EXPECT_EQ(profile->count, 0);
+        EXPECT_EQ(profile->total, 0);
+        EXPECT_EQ(profile->max, 0);
+    }
+}
@@ -0,0 +1,139 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <iostream>
+#include <random>
+
+#include "test_common.hpp"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+
+extern RGB      rgb_matrix_test_frame[DRIVER_LED_TOTAL];
+extern uint32_t rgb_matrix_test_flushes;
+extern uint32_t reactive_index_mismatches;
+extern uint32_t reactive_index_lit;
+}
+
+class RgbMatrix : public TestFixture {
+   public:
+    TestDriver driver;
+
+    void SetUp() override {
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_sethsv_noeeprom(0, UINT8_MAX, UINT8_MAX);
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+        next_frame();
+    }
+
+    // Run the matrix task until the driver has been flushed once more
+    void next_frame(void) {
+        uint32_t flushes = rgb_matrix_test_flushes;
+        while (rgb_matrix_test_flushes == flushes) {
+            run_one_scan_loop();
+        }
+    }
+
+    bool is_off(uint8_t i) {
+        return rgb_matrix_test_frame[i].r == 0 && rgb_matrix_test_frame[i].g == 0 && rgb_matrix_test_frame[i].b == 0;
+    }
+};
+
+TEST_F(RgbMatrix, ArenaHoldsTheLargestEffectState) {
+    uint16_t largest = 0;
+    for (uint8_t mode = 1; mode < RGB_MATRIX_EFFECT_MAX; mode++) {
+        uint16_t size = rgb_matrix_get_effect_state_size(mode);
+        if (size) {
+            std::cout << "effect " << (int)mode << ": " << size << " bytes of state" << std::endl;
+        }
+        largest = size > largest ? size : largest;
+    }
+    std::cout << "arena: " << rgb_matrix_get_effect_arena_size() << " bytes" << std::endl;
+
+    EXPECT_EQ(rgb_matrix_get_effect_state_size(RGB_MATRIX_SOLID_COLOR), 0);
+    EXPECT_EQ(rgb_matrix_get_effect_state_size(RGB_MATRIX_CUSTOM_FRAME_COUNTER), 2);
+    EXPECT_GE(rgb_matrix_get_effect_state_size(RGB_MATRIX_TYPING_HEATMAP), MATRIX_ROWS * MATRIX_COLS);
+    EXPECT_GE(rgb_matrix_get_effect_state_size(RGB_MATRIX_DIGITAL_RAIN), MATRIX_ROWS * MATRIX_COLS);
+    EXPECT_EQ(rgb_matrix_get_effect_arena_size(), largest);
+}
+
+TEST_F(RgbMatrix, StateStartsZeroedForEachEffect) {
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_CUSTOM_FRAME_COUNTER);
+    for (uint8_t frame = 1; frame <= 5; frame++) {
+        next_frame();
+        EXPECT_EQ(rgb_matrix_test_frame[0].r, frame);
+    }
+
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+    next_frame();
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_CUSTOM_FRAME_COUNTER);
+    next_frame();
+    EXPECT_EQ(rgb_matrix_test_frame[0].r, 1);
+
+    // Turning the matrix off and on restarts the effect too
+    rgb_matrix_disable_noeeprom();
+    next_frame();
+    rgb_matrix_enable_noeeprom();
+    next_frame();
+    EXPECT_EQ(rgb_matrix_test_frame[0].r, 1);
+}
+
+TEST_F(RgbMatrix, TypingHeatmapKeepsItsHeatInTheArena) {
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_TYPING_HEATMAP);
+    next_frame();
+    EXPECT_TRUE(is_off(0));
+
+    process_rgb_matrix(0, 0, true);
+    next_frame();
+    EXPECT_FALSE(is_off(0));
+    EXPECT_TRUE(is_off(DRIVER_LED_TOTAL - 1));
+
+    // Digital rain reuses the same memory, and the heat is gone once the heatmap is back
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_DIGITAL_RAIN);
+    idle_for(1000);
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_TYPING_HEATMAP);
+    next_frame();
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        EXPECT_TRUE(is_off(i)) << "LED " << (int)i;
+    }
+}
+
+TEST_F(RgbMatrix, IndexedReactiveEffectsMatchThePlainRunner) {
+    std::mt19937 rng(50);
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_CUSTOM_REACTIVE_INDEX_CHECK);
+    reactive_index_mismatches = 0;
+    reactive_index_lit        = 0;
+
+    for (uint8_t speed : {0, 32, 127, 255}) {
+        rgb_matrix_set_speed_noeeprom(speed);
+        for (int scan = 0; scan < 5000; scan++) {
+            // Bursts of typing, with pauses long enough for the splashes to run off the board,
+            // keys are hit in between the iterations of a frame too
+            if (scan % 1000 == 999) {
+                idle_for(rng() % 3000);
+            }
+            if (rng() % 30 == 0) {
+                process_rgb_matrix(rng() % MATRIX_ROWS, rng() % MATRIX_COLS, true);
+            }
+            run_one_scan_loop();
+        }
+    }
+
+    EXPECT_EQ(reactive_index_mismatches, 0);
+    EXPECT_GT(reactive_index_lit, 0);
+}
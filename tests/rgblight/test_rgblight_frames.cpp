@@ -0,0 +1,86 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "rgblight.h"
+
+extern LED_TYPE ws2812_test_frame[RGBLED_NUM];
+extern uint16_t ws2812_test_num_leds;
+extern uint32_t ws2812_test_calls;
+}
+
+class RgblightFrames : public TestFixture {
+   public:
+    void SetUp() override {
+        rgblight_enable_noeeprom();
+        rgblight_mode_noeeprom(RGBLIGHT_MODE_STATIC_LIGHT);
+        rgblight_set_clipping_range(0, RGBLED_NUM);
+        rgblight_setrgb(0, 0, 0);
+        ws2812_test_calls = 0;
+        rgblight_reset_frame_stats();
+    }
+
+    rgblight_frame_stats_t stats(void) {
+        rgblight_frame_stats_t stats;
+        rgblight_get_frame_stats(&stats);
+        return stats;
+    }
+};
+
+TEST_F(RgblightFrames, UnchangedFramesAreSkipped) {
+    rgblight_set();
+    rgblight_set();
+    rgblight_setrgb(0, 0, 0);
+
+    EXPECT_EQ(ws2812_test_calls, 0);
+    EXPECT_EQ(stats().sent, 0);
+    EXPECT_EQ(stats().skipped, 3);
+}
+
+TEST_F(RgblightFrames, ChangedLedIsSentThroughLedMap) {
+    rgblight_setrgb_at(10, 20, 30, 1);
+    rgblight_set();
+
+    EXPECT_EQ(ws2812_test_calls, 1);
+    EXPECT_EQ(ws2812_test_num_leds, RGBLED_NUM);
+    // RGBLIGHT_LED_MAP reverses the strip
+    EXPECT_EQ(ws2812_test_frame[6].r, 10);
+    EXPECT_EQ(ws2812_test_frame[6].g, 20);
+    EXPECT_EQ(ws2812_test_frame[6].b, 30);
+    EXPECT_EQ(ws2812_test_frame[1].r, 0);
+    EXPECT_EQ(stats().sent, 1);
+    EXPECT_EQ(stats().skipped, 1);
+}
+
+TEST_F(RgblightFrames, ForcedFrameIsSent) {
+    rgblight_force_next_frame();
+    rgblight_set();
+    rgblight_set();
+
+    EXPECT_EQ(ws2812_test_calls, 1);
+}
+
+TEST_F(RgblightFrames, ClippingRangeChangeIsSent) {
+    rgblight_set_clipping_range(2, 4);
+    rgblight_set();
+
+    EXPECT_EQ(ws2812_test_calls, 1);
+    EXPECT_EQ(ws2812_test_num_leds, 4);
+}
@@ -0,0 +1,17 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "ws2812.h"
+
+// Stands in for the ws2812 driver, recording what would have been sent to the strip
+LED_TYPE ws2812_test_frame[RGBLED_NUM];
+uint16_t ws2812_test_num_leds;
+uint32_t ws2812_test_calls;
+
+void ws2812_setleds(LED_TYPE *ledarray, uint16_t number_of_leds) {
+    for (uint16_t i = 0; i < number_of_leds; i++) {
+        ws2812_test_frame[i] = ledarray[i];
+    }
+    ws2812_test_num_leds = number_of_leds;
+    ws2812_test_calls++;
+}
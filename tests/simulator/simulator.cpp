@@ -0,0 +1,216 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "simulator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+
+extern "C" {
+#include "host.h"
+#include "test_matrix.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+}
+
+bool read_trace(std::istream& in, std::vector<TraceEvent>& trace) {
+    std::string line;
+    while (std::getline(in, line)) {
+        line = line.substr(0, line.find('#'));
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+
+        std::istringstream fields(line);
+        uint32_t           time;
+        unsigned           row, col;
+        char               edge;
+        if (!(fields >> time >> row >> col >> edge) || row >= MATRIX_ROWS || col >= MATRIX_COLS || (edge != 'd' && edge != 'u')) {
+            return false;
+        }
+        trace.push_back({time, (uint8_t)row, (uint8_t)col, edge == 'd'});
+    }
+    return true;
+}
+
+void write_trace(std::ostream& out, const std::vector<TraceEvent>& trace) {
+    for (const TraceEvent& event : trace) {
+        out << event.time << " " << +event.row << " " << +event.col << " " << (event.pressed ? 'd' : 'u') << "\n";
+    }
+}
+
+namespace {
+
+// xorshift32, for traces that do not depend on the standard library in use
+class Random {
+   public:
+    explicit Random(uint32_t seed) : m_state(seed ? seed : 1) {}
+
+    uint32_t next(void) {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 17;
+        m_state ^= m_state << 5;
+        return m_state;
+    }
+
+    uint32_t between(uint32_t min, uint32_t max) {
+        return min + next() % (max - min + 1);
+    }
+
+   private:
+    uint32_t m_state;
+};
+
+} // namespace
+
+std::vector<TraceEvent> generate_typing_trace(const std::vector<keypos_t>& keys, const std::vector<std::pair<keypos_t, keypos_t>>& chords, uint32_t duration_ms, uint32_t seed) {
+    Random                  random(seed);
+    std::vector<TraceEvent> trace;
+    // When each key is released again, so that no key is pressed twice at once
+    std::vector<uint32_t> released(MATRIX_ROWS * MATRIX_COLS, 0);
+
+    auto add_keystroke = [&](keypos_t key, uint32_t down, uint32_t hold) {
+        trace.push_back({down, key.row, key.col, true});
+        trace.push_back({down + hold, key.row, key.col, false});
+        released[key.row * MATRIX_COLS + key.col] = down + hold + 1;
+    };
+    auto is_free = [&](keypos_t key, uint32_t time) { return released[key.row * MATRIX_COLS + key.col] <= time; };
+
+    // Sum of two uniform distributions, for gaps clustering around 120ms
+    for (uint32_t time = 0; time < duration_ms; time += random.between(20, 100) + random.between(20, 100)) {
+        uint32_t kind = random.between(0, 99);
+        if (kind < 2 && !chords.empty()) {
+            auto& chord = chords[random.between(0, chords.size() - 1)];
+            if (is_free(chord.first, time) && is_free(chord.second, time)) {
+                add_keystroke(chord.first, time, random.between(40, 90));
+                add_keystroke(chord.second, time + random.between(1, 15), random.between(40, 90));
+            }
+        } else {
+            keypos_t key = keys[random.between(0, keys.size() - 1)];
+            if (is_free(key, time)) {
+                // Mostly taps, some overlapping the next key, and a few long holds
+                uint32_t hold = kind < 7 ? random.between(220, 400) : random.between(30, 140);
+                add_keystroke(key, time, hold);
+            }
+        }
+    }
+
+    std::stable_sort(trace.begin(), trace.end(), [](const TraceEvent& a, const TraceEvent& b) { return a.time < b.time; });
+    return trace;
+}
+
+namespace {
+
+SimulationResult* current_result = nullptr;
+uint32_t          start_time     = 0;
+
+uint8_t simulator_keyboard_leds(void) {
+    return 0;
+}
+
+void simulator_send_keyboard(report_keyboard_t* report) {
+    current_result->reports.push_back({timer_read32() - start_time, *report});
+}
+
+void simulator_send_mouse(report_mouse_t* report) {}
+void simulator_send_system(uint16_t data) {}
+void simulator_send_consumer(uint16_t data) {}
+
+host_driver_t simulator_driver = {simulator_keyboard_leds, simulator_send_keyboard, simulator_send_mouse, simulator_send_system, simulator_send_consumer};
+
+} // namespace
+
+SimulationResult simulate(const std::vector<TraceEvent>& trace, uint32_t settle_ms) {
+    using clock = std::chrono::steady_clock;
+
+    SimulationResult result;
+    host_driver_t*   previous_driver = host_get_driver();
+    current_result                   = &result;
+    start_time                       = timer_read32();
+    host_set_driver(&simulator_driver);
+    result.event_ns.resize(trace.size());
+
+    auto     wall_start = clock::now();
+    size_t   next       = 0;
+    uint32_t end        = (trace.empty() ? 0 : trace.back().time) + settle_ms;
+    while (next < trace.size() || result.simulated_ms < end) {
+        // Apply all edges of this millisecond, for the next scan to see them together
+        size_t first = next;
+        while (next < trace.size() && trace[next].time <= result.simulated_ms) {
+            if (trace[next].pressed) {
+                press_key(trace[next].col, trace[next].row);
+            } else {
+                release_key(trace[next].col, trace[next].row);
+            }
+            next++;
+        }
+
+        auto scan_start = clock::now();
+        keyboard_task();
+        uint64_t scan_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - scan_start).count();
+        for (size_t i = first; i < next; i++) {
+            result.event_ns[i] = scan_ns / (next - first);
+        }
+
+        advance_time(1);
+        result.simulated_ms++;
+        result.scans++;
+    }
+    result.wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - wall_start).count();
+
+    host_set_driver(previous_driver);
+    current_result = nullptr;
+    return result;
+}
+
+std::string format_report(const report_keyboard_t& report) {
+    char text[4 + 3 * KEYBOARD_REPORT_KEYS];
+    int  length = snprintf(text, sizeof(text), "%02X", report.mods);
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        length += snprintf(text + length, sizeof(text) - length, " %02X", report.keys[i]);
+    }
+    return text;
+}
+
+void write_result(std::ostream& out, const std::vector<TraceEvent>& trace, const SimulationResult& result, bool with_events) {
+    size_t event        = 0;
+    auto   write_events = [&](uint32_t until) {
+        for (; with_events && event < trace.size() && trace[event].time <= until; event++) {
+            out << trace[event].time << " event " << +trace[event].row << " " << +trace[event].col << " " << (trace[event].pressed ? 'd' : 'u') << " " << result.event_ns[event] << "ns\n";
+        }
+    };
+
+    for (const SimulatedReport& report : result.reports) {
+        // Events come before the reports they caused, which happen in the same millisecond at the earliest
+        write_events(report.time);
+        out << report.time << " report " << format_report(report.report) << "\n";
+    }
+    write_events(UINT32_MAX);
+}
+
+void print_summary(std::ostream& out, const SimulationResult& result) {
+    std::vector<uint64_t> costs(result.event_ns);
+    std::sort(costs.begin(), costs.end());
+    auto percentile = [&](unsigned p) { return costs.empty() ? 0 : costs[(costs.size() - 1) * p / 100]; };
+
+    out << result.event_ns.size() << " events, " << result.reports.size() << " reports in " << result.simulated_ms << " simulated ms, " << result.scans << " scans" << std::endl;
+    out << "per event: p50 " << percentile(50) << "ns, p99 " << percentile(99) << "ns, max " << percentile(100) << "ns" << std::endl;
+    out << "per scan: " << (result.scans ? result.wall_ns / result.scans : 0) << "ns, " << (result.wall_ns ? (uint64_t)result.simulated_ms * 1000000 / result.wall_ns : 0) << "x faster than real time" << std::endl;
+}
@@ -0,0 +1,84 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include "keyboard.h"
+#include "report.h"
+}
+
+/**
+ * @brief A switch changing state: `time` in milliseconds from the start of the trace.
+ */
+struct TraceEvent {
+    uint32_t time;
+    uint8_t  row;
+    uint8_t  col;
+    bool     pressed;
+};
+
+struct SimulatedReport {
+    uint32_t          time;
+    report_keyboard_t report;
+};
+
+struct SimulationResult {
+    std::vector<SimulatedReport> reports;
+    std::vector<uint64_t>        event_ns; // cost of the scan each event was seen in, shared by all events in it
+    uint32_t                     simulated_ms = 0;
+    uint64_t                     scans        = 0;
+    uint64_t                     wall_ns      = 0;
+};
+
+/**
+ * @brief Reads a trace of lines `<time> <row> <col> <d|u>`, ignoring empty lines and `#` comments.
+ *
+ * Returns false on the first line that does not parse.
+ */
+bool read_trace(std::istream& in, std::vector<TraceEvent>& trace);
+void write_trace(std::ostream& out, const std::vector<TraceEvent>& trace);
+
+/**
+ * @brief Generates `duration_ms` of typing on `keys`, with rolls, holds and chords.
+ *
+ * The same seed always results in the same trace, on any host.
+ */
+std::vector<TraceEvent> generate_typing_trace(const std::vector<keypos_t>& keys, const std::vector<std::pair<keypos_t, keypos_t>>& chords, uint32_t duration_ms, uint32_t seed);
+
+/**
+ * @brief Replays a trace through keyboard_task(), one scan per millisecond, followed by `settle_ms` without changes.
+ */
+SimulationResult simulate(const std::vector<TraceEvent>& trace, uint32_t settle_ms);
+
+std::string format_report(const report_keyboard_t& report);
+
+/**
+ * @brief Writes the reports, and optionally the events with their cost, in the order they happened.
+ */
+void write_result(std::ostream& out, const std::vector<TraceEvent>& trace, const SimulationResult& result, bool with_events);
+
+/**
+ * @brief Prints the number of events, scans and reports, and the processing cost per event.
+ */
+void print_summary(std::ostream& out, const SimulationResult& result);
@@ -0,0 +1,156 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+#include "simulator.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+extern "C" {
+enum combo_events { JK_COMBO, COMBO_LENGTH };
+uint16_t COMBO_LEN = COMBO_LENGTH;
+
+const uint16_t jk_combo[] PROGMEM = {KC_J, KC_K, COMBO_END};
+
+combo_t key_combos[] = {
+    [JK_COMBO] = COMBO(jk_combo, KC_ESC),
+};
+}
+
+/*
+ * Replays key traces through the whole keyboard loop, see simulator.hpp.
+ *
+ * To replay a recorded trace and write the reports it results in, with the
+ * cost of each event:
+ *
+ *   QMK_SIMULATOR_TRACE=typing.trace QMK_SIMULATOR_OUTPUT=typing.out .build/test/simulator.elf
+ *
+ * QMK_SIMULATOR_UPDATE=1 rewrites the expected reports of the traces in tests/simulator/traces.
+ */
+class Simulator : public TestFixture {
+   public:
+    void SetUp() override {
+        // clang-format off
+        set_keymap({
+            KeymapKey(0, 0, 0, KC_Q), KeymapKey(0, 1, 0, KC_W), KeymapKey(0, 2, 0, KC_E), KeymapKey(0, 3, 0, KC_R), KeymapKey(0, 4, 0, KC_T),
+            KeymapKey(0, 5, 0, KC_Y), KeymapKey(0, 6, 0, KC_U), KeymapKey(0, 7, 0, KC_I), KeymapKey(0, 8, 0, KC_O), KeymapKey(0, 9, 0, KC_P),
+            KeymapKey(0, 0, 1, LCTL_T(KC_A)), KeymapKey(0, 1, 1, KC_S), KeymapKey(0, 2, 1, KC_D), KeymapKey(0, 3, 1, KC_F), KeymapKey(0, 4, 1, KC_G),
+            KeymapKey(0, 5, 1, KC_H), KeymapKey(0, 6, 1, KC_J), KeymapKey(0, 7, 1, KC_K), KeymapKey(0, 8, 1, KC_L), KeymapKey(0, 9, 1, RSFT_T(KC_SCLN)),
+            KeymapKey(0, 0, 2, KC_Z), KeymapKey(0, 1, 2, KC_X), KeymapKey(0, 2, 2, KC_C), KeymapKey(0, 3, 2, KC_V), KeymapKey(0, 4, 2, KC_B),
+            KeymapKey(0, 5, 2, KC_N), KeymapKey(0, 6, 2, KC_M), KeymapKey(0, 7, 2, KC_COMM), KeymapKey(0, 8, 2, KC_DOT), KeymapKey(0, 9, 2, KC_SLSH),
+            KeymapKey(0, 0, 3, KC_LGUI), KeymapKey(0, 1, 3, KC_LALT), KeymapKey(0, 2, 3, LT(1, KC_SPC)), KeymapKey(0, 3, 3, KC_ENT), KeymapKey(0, 4, 3, KC_BSPC),
+            KeymapKey(1, 0, 0, KC_1), KeymapKey(1, 1, 0, KC_2), KeymapKey(1, 2, 0, KC_3), KeymapKey(1, 3, 0, KC_4), KeymapKey(1, 4, 0, KC_5),
+        });
+        // clang-format on
+        for (uint8_t row = 0; row < 4; row++) {
+            for (uint8_t col = row == 0 ? 5 : 0; col < (row == 3 ? 5 : 10); col++) {
+                add_key(KeymapKey(1, col, row, KC_TRNS));
+            }
+        }
+    }
+
+    std::vector<keypos_t> typing_keys(void) {
+        std::vector<keypos_t> keys;
+        for (uint8_t row = 0; row < 3; row++) {
+            for (uint8_t col = 0; col < 10; col++) {
+                keys.push_back({col, row});
+            }
+        }
+        // Space, as often as a letter would be several times over
+        keys.insert(keys.end(), 6, {2, 3});
+        return keys;
+    }
+
+    std::vector<std::pair<keypos_t, keypos_t>> typing_chords(void) {
+        return {{{6, 1}, {7, 1}}};
+    }
+
+    std::string reports_of(const SimulationResult& result) {
+        std::ostringstream reports;
+        write_result(reports, {}, result, false);
+        return reports.str();
+    }
+};
+
+TEST_F(Simulator, TapHoldComboAndAutoShiftTraceMatchesRecordedReports) {
+    const std::string       path = "tests/simulator/traces/tap_hold_combo_auto_shift";
+    std::ifstream           trace_file(path + ".trace");
+    std::vector<TraceEvent> trace;
+    ASSERT_TRUE(trace_file.is_open()) << path << ".trace";
+    ASSERT_TRUE(read_trace(trace_file, trace));
+
+    std::string reports = reports_of(simulate(trace, TAPPING_TERM * 10));
+
+    if (getenv("QMK_SIMULATOR_UPDATE")) {
+        std::ofstream(path + ".reports") << reports;
+    }
+    std::ifstream      expected_file(path + ".reports");
+    std::ostringstream expected;
+    expected << expected_file.rdbuf();
+    EXPECT_EQ(reports, expected.str());
+}
+
+TEST_F(Simulator, ReplayIsDeterministic) {
+    std::vector<TraceEvent> trace = generate_typing_trace(typing_keys(), typing_chords(), 5 * 60 * 1000, 42);
+
+    SimulationResult first  = simulate(trace, TAPPING_TERM * 10);
+    SimulationResult second = simulate(trace, TAPPING_TERM * 10);
+
+    EXPECT_EQ(reports_of(first), reports_of(second));
+    ASSERT_FALSE(first.reports.empty());
+    EXPECT_EQ(format_report(first.reports.back().report), format_report(report_keyboard_t{}));
+
+    print_summary(std::cout, first);
+}
+
+TEST_F(Simulator, GeneratedTraceRoundTrips) {
+    std::vector<TraceEvent> trace = generate_typing_trace(typing_keys(), typing_chords(), 10 * 1000, 7);
+    std::stringstream       text;
+    std::vector<TraceEvent> read;
+
+    write_trace(text, trace);
+    ASSERT_TRUE(read_trace(text, read));
+
+    std::stringstream again;
+    write_trace(again, read);
+    EXPECT_EQ(text.str(), again.str());
+}
+
+TEST_F(Simulator, ReplayTraceFromEnvironment) {
+    const char* trace_path = getenv("QMK_SIMULATOR_TRACE");
+    if (!trace_path) {
+        GTEST_SKIP() << "QMK_SIMULATOR_TRACE not set";
+    }
+
+    std::ifstream           trace_file(trace_path);
+    std::vector<TraceEvent> trace;
+    ASSERT_TRUE(trace_file.is_open()) << trace_path;
+    ASSERT_TRUE(read_trace(trace_file, trace)) << trace_path << " is not a trace";
+
+    SimulationResult result = simulate(trace, TAPPING_TERM * 10);
+
+    if (const char* output_path = getenv("QMK_SIMULATOR_OUTPUT")) {
+        std::ofstream output(output_path);
+        write_result(output, trace, result, true);
+    }
+    print_summary(std::cout, result);
+}
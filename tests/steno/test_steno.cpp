@@ -0,0 +1,163 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+#include <vector>
+
+extern "C" {
+#include "keymap_steno.h"
+#include "process_steno.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+typedef std::vector<uint8_t> packet_t;
+
+// Every write to the virtual serial port, as it was handed over
+static std::vector<packet_t> serial_writes;
+
+extern "C" {
+void virtser_init(void) {}
+
+void virtser_send(const uint8_t byte) {
+    serial_writes.push_back(packet_t{byte});
+}
+
+void virtser_send_buffer(const uint8_t *data, uint8_t length) {
+    serial_writes.push_back(packet_t(data, data + length));
+}
+}
+
+class Steno : public TestFixture {
+   public:
+    void SetUp() override {
+        serial_writes.clear();
+        steno_set_mode(STENO_MODE_GEMINI);
+        set_keymap({key_s1, key_tl, key_kl, key_pl, key_wl, key_hl, key_rl, key_a, key_e, key_u, key_br, key_gr, key_zr});
+    }
+
+    void chord(std::vector<KeymapKey *> keys) {
+        for (auto key : keys) {
+            key->press();
+            run_one_scan_loop();
+        }
+        for (auto key : keys) {
+            key->release();
+            run_one_scan_loop();
+        }
+    }
+
+    KeymapKey key_s1 = KeymapKey(0, 0, 0, STN_S1);
+    KeymapKey key_tl = KeymapKey(0, 1, 0, STN_TL);
+    KeymapKey key_kl = KeymapKey(0, 2, 0, STN_KL);
+    KeymapKey key_pl = KeymapKey(0, 3, 0, STN_PL);
+    KeymapKey key_wl = KeymapKey(0, 4, 0, STN_WL);
+    KeymapKey key_hl = KeymapKey(0, 5, 0, STN_HL);
+    KeymapKey key_rl = KeymapKey(0, 6, 0, STN_RL);
+    KeymapKey key_a  = KeymapKey(0, 7, 0, STN_A);
+    KeymapKey key_e  = KeymapKey(0, 0, 1, STN_E);
+    KeymapKey key_u  = KeymapKey(0, 1, 1, STN_U);
+    KeymapKey key_br = KeymapKey(0, 2, 1, STN_BR);
+    KeymapKey key_gr = KeymapKey(0, 3, 1, STN_GR);
+    KeymapKey key_zr = KeymapKey(0, 4, 1, STN_ZR);
+};
+
+TEST_F(Steno, GeminiChordIsOneSerialWrite) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+
+    chord({&key_wl, &key_a, &key_zr});
+
+    ASSERT_EQ(serial_writes.size(), 1);
+    EXPECT_EQ(serial_writes[0], (packet_t{0b10000000, 0b00000010, 0b00100000, 0b00000000, 0b00000000, 0b00000001}));
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Steno, BoltChordSkipsEmptyGroups) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    steno_set_mode(STENO_MODE_BOLT);
+
+    chord({&key_wl, &key_a, &key_zr});
+    chord({&key_e, &key_u, &key_br, &key_gr});
+
+    ASSERT_EQ(serial_writes.size(), 2);
+    EXPECT_EQ(serial_writes[0], (packet_t{0b00010000, 0b01000010, 0b11001000, 0}));
+    EXPECT_EQ(serial_writes[1], (packet_t{0b01110000, 0b10101000, 0}));
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Steno, ChordIsSentOnceAllKeysAreReleased) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+
+    // Rolling from W- to -Z while still holding A- forms a single chord
+    key_wl.press();
+    run_one_scan_loop();
+    key_a.press();
+    run_one_scan_loop();
+    key_wl.release();
+    run_one_scan_loop();
+    key_zr.press();
+    run_one_scan_loop();
+    key_a.release();
+    run_one_scan_loop();
+    EXPECT_TRUE(serial_writes.empty());
+
+    key_zr.release();
+    run_one_scan_loop();
+
+    ASSERT_EQ(serial_writes.size(), 1);
+    EXPECT_EQ(serial_writes[0], (packet_t{0b10000000, 0b00000010, 0b00100000, 0b00000000, 0b00000000, 0b00000001}));
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Steno, HidChordTypesPloverKeyboardLayout) {
+    TestDriver driver;
+    steno_set_mode(STENO_MODE_HID);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_N, KC_M, KC_K, KC_L));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    chord({&key_e, &key_u, &key_br, &key_gr});
+
+    EXPECT_TRUE(serial_writes.empty());
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Steno, HidChordSlidesThroughSixKeyReport) {
+    TestDriver driver;
+    steno_set_mode(STENO_MODE_HID);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_Q, KC_W, KC_S, KC_E, KC_D, KC_R));
+        EXPECT_REPORT(driver, (KC_W, KC_S, KC_E, KC_D, KC_R, KC_F));
+        EXPECT_REPORT(driver, (KC_S, KC_E, KC_D, KC_R, KC_F, KC_C));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    chord({&key_s1, &key_tl, &key_kl, &key_pl, &key_wl, &key_hl, &key_rl, &key_a});
+
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
@@ -0,0 +1,170 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+class WaitingBuffer : public TestFixture {
+   public:
+    void SetUp() override {
+        waiting_buffer_clear_stats();
+    }
+
+    /* Roll over keys, pressing the next one before releasing the previous. */
+    void roll_keys(std::vector<KeymapKey> &keys, unsigned delay_ms) {
+        for (size_t i = 0; i < keys.size(); i++) {
+            keys[i].press();
+            run_one_scan_loop();
+            idle_for(delay_ms);
+            if (i > 0) {
+                keys[i - 1].release();
+                run_one_scan_loop();
+                idle_for(delay_ms);
+            }
+        }
+        keys.back().release();
+        run_one_scan_loop();
+    }
+};
+
+TEST_F(WaitingBuffer, rollover_burst_while_mod_tap_key_is_held) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_hold_key = KeymapKey(0, 0, 0, SFT_T(KC_P));
+
+    std::vector<KeymapKey> keys = {KeymapKey(0, 1, 0, KC_A), KeymapKey(0, 2, 0, KC_B), KeymapKey(0, 3, 0, KC_C), KeymapKey(0, 4, 0, KC_D), KeymapKey(0, 5, 0, KC_E), KeymapKey(0, 6, 0, KC_F)};
+
+    set_keymap({mod_tap_hold_key, keys[0], keys[1], keys[2], keys[3], keys[4], keys[5]});
+
+    /* Press mod-tap-hold key. */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_hold_key.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    /* Roll over six keys at roughly 40 keys/s, all within the tapping term. */
+    EXPECT_NO_REPORT(driver);
+    roll_keys(keys, 10);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    /* Once the tapping term expires every buffered event is replayed shifted. */
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_A));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_B));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_B, KC_C));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_C));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_C, KC_D));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_D));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_D, KC_E));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_E));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_E, KC_F));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_F));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    idle_for(TAPPING_TERM);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    /* Release mod-tap-hold key. */
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_hold_key.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    waiting_buffer_stats_t stats;
+    waiting_buffer_get_stats(&stats);
+    EXPECT_EQ(stats.overflows, 0);
+    EXPECT_EQ(stats.high_water, 12);
+}
+
+TEST_F(WaitingBuffer, repeated_taps_of_one_key_are_held_back) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_hold_key = KeymapKey(0, 0, 0, SFT_T(KC_P));
+    auto       regular_key      = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({mod_tap_hold_key, regular_key});
+
+    /* Press mod-tap-hold key. */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_hold_key.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    /* Each release pairs with a queued press of the same key, so it is held back as well. */
+    EXPECT_NO_REPORT(driver);
+    for (int i = 0; i < 3; i++) {
+        regular_key.press();
+        run_one_scan_loop();
+        regular_key.release();
+        run_one_scan_loop();
+    }
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    /* Once the tapping term expires all three taps are replayed shifted. */
+    EXPECT_REPORT(driver, (KC_LSFT));
+    for (int i = 0; i < 3; i++) {
+        EXPECT_REPORT(driver, (KC_LSFT, KC_A));
+        EXPECT_REPORT(driver, (KC_LSFT));
+    }
+    idle_for(TAPPING_TERM);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    /* Release mod-tap-hold key. */
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_hold_key.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(WaitingBuffer, overflow_is_counted) {
+    TestDriver driver;
+    auto       mod_tap_hold_key = KeymapKey(0, 0, 0, SFT_T(KC_P));
+
+    std::vector<KeymapKey> keys;
+    for (uint8_t i = 0; i < 9; i++) {
+        keys.push_back(KeymapKey(0, 1 + i, 0, KC_A + i));
+    }
+
+    set_keymap({mod_tap_hold_key, keys[0], keys[1], keys[2], keys[3], keys[4], keys[5], keys[6], keys[7], keys[8]});
+
+    /* Press mod-tap-hold key. */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_hold_key.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    /* 18 events within the tapping term do not fit into the buffer. */
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    roll_keys(keys, 5);
+    mod_tap_hold_key.release();
+    run_one_scan_loop();
+    idle_for(TAPPING_TERM);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    waiting_buffer_stats_t stats;
+    waiting_buffer_get_stats(&stats);
+    EXPECT_EQ(stats.overflows, 1);
+    EXPECT_EQ(stats.high_water, WAITING_BUFFER_SIZE - 1);
+}
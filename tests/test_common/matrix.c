@@ -38,7 +38,12 @@ void matrix_print(void) {}
 
 void matrix_init_kb(void) {}
 
-void matrix_scan_kb(void) {}
+// Called from matrix_scan, before the quantum tasks, as on a keyboard
+__attribute__((weak)) void matrix_scan_user(void) {}
+
+void matrix_scan_kb(void) {
+    matrix_scan_user();
+}
 
 void press_key(uint8_t col, uint8_t row) {
     matrix[row] |= 1 << col;
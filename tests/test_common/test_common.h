@@ -1,4 +1,9 @@
 #pragma once
 
-#define MATRIX_ROWS 4
-#define MATRIX_COLS 10
\ No newline at end of file
+// Suites can use a bigger matrix by defining these before including this file
+#ifndef MATRIX_ROWS
+#    define MATRIX_ROWS 4
+#endif
+#ifndef MATRIX_COLS
+#    define MATRIX_COLS 10
+#endif
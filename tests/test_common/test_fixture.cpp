@@ -33,12 +33,15 @@ using testing::_;
 TestFixture* TestFixture::m_this = nullptr;
 
 /* Override weak QMK function to allow the usage of isolated per-test keymaps in unit-tests.
- * The actual call is dynamicaly dispatched to the current active test fixture, which in turn has it's own keymap. */
+ * The actual call is dynamicaly dispatched to the current active test fixture, which in turn has it's own keymap.
+ * Suites with a dynamic keymap use the one in EEPROM instead. */
+#ifndef DYNAMIC_KEYMAP_ENABLE
 extern "C" uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t position) {
     uint16_t keycode;
     TestFixture::m_this->get_keycode(layer, position, &keycode);
     return keycode;
 }
+#endif
 
 void TestFixture::SetUpTestCase() {
     test_logger.info() << "TestFixture setup-up start." << std::endl;
@@ -0,0 +1,135 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::AnyOf;
+using testing::InSequence;
+
+class Unicode : public TestFixture {
+   public:
+    void SetUp() override {
+        set_unicode_input_mode(UC_LNX);
+    }
+};
+
+TEST_F(Unicode, StringSharesOneInputSession) {
+    TestDriver driver;
+    driver.set_leds(1 << USB_LED_CAPS_LOCK);
+
+    // Allow any number of reports with no keys, or only the mods of UNICODE_KEY_LNX.
+    // clang-format off
+    EXPECT_CALL(driver, send_keyboard_mock(AnyOf(
+                KeyboardReport(),
+                KeyboardReport(KC_LCTL),
+                KeyboardReport(KC_LCTL, KC_LSFT))))
+        .Times(AnyNumber());
+    // clang-format on
+    {
+        InSequence s;
+        // Caps Lock is only turned off for the whole string, and back on after it
+        EXPECT_REPORT(driver, (KC_CAPS));
+        EXPECT_UNICODE(driver, 0x03b4);
+        EXPECT_UNICODE(driver, 0x2192);
+        EXPECT_UNICODE(driver, 0x1f600);
+        EXPECT_REPORT(driver, (KC_CAPS));
+    }
+    send_unicode_string("δ→😀");
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Unicode, MacTypesStringWhileHoldingInputKey) {
+    TestDriver driver;
+    set_unicode_input_mode(UC_MAC);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_LALT));
+        EXPECT_REPORT(driver, (KC_LALT, KC_0));
+        EXPECT_REPORT(driver, (KC_LALT));
+        EXPECT_REPORT(driver, (KC_LALT, KC_3));
+        EXPECT_REPORT(driver, (KC_LALT));
+        EXPECT_REPORT(driver, (KC_LALT, KC_B));
+        EXPECT_REPORT(driver, (KC_LALT));
+        EXPECT_REPORT(driver, (KC_LALT, KC_4));
+        EXPECT_REPORT(driver, (KC_LALT));
+        EXPECT_REPORT(driver, (KC_LALT, KC_2));
+        EXPECT_REPORT(driver, (KC_LALT));
+        EXPECT_REPORT(driver, (KC_LALT, KC_1));
+        EXPECT_REPORT(driver, (KC_LALT));
+        EXPECT_REPORT(driver, (KC_LALT, KC_9));
+        EXPECT_REPORT(driver, (KC_LALT));
+        EXPECT_REPORT(driver, (KC_LALT, KC_2));
+        EXPECT_REPORT(driver, (KC_LALT));
+        // The input key is released only once, after the last code point
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    send_unicode_string("δ→");
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Unicode, UnsupportedCodePointsAreSkipped) {
+    TestDriver driver;
+
+    // Nothing is sent at all for a string without anything to type
+    EXPECT_NO_REPORT(driver);
+    send_unicode_string("");
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // Windows' Alt code input stops at U+FFFF
+    set_unicode_input_mode(UC_WIN);
+    EXPECT_NO_REPORT(driver);
+    send_unicode_string("😀");
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // Past U+10FFFF, encoded the way UTF-8 would if it went that far
+    set_unicode_input_mode(UC_LNX);
+    EXPECT_NO_REPORT(driver);
+    send_unicode_string("\xF4\x90\x80\x80");
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // clang-format off
+    EXPECT_CALL(driver, send_keyboard_mock(AnyOf(
+                KeyboardReport(),
+                KeyboardReport(KC_LCTL),
+                KeyboardReport(KC_LCTL, KC_LSFT))))
+        .Times(AnyNumber());
+    // clang-format on
+    {
+        InSequence s;
+        EXPECT_UNICODE(driver, 0x03b4);
+        EXPECT_UNICODE(driver, 0x2192);
+    }
+    send_unicode_string("δ\xF4\x90\x80\x80→");
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Unicode, ModsAreRestoredAfterString) {
+    TestDriver driver;
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    add_mods(MOD_BIT(KC_LSFT));
+    send_unicode_string("δδ");
+    EXPECT_EQ(get_mods(), MOD_BIT(KC_LSFT));
+    clear_mods();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
@@ -0,0 +1,301 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+#include <vector>
+
+extern "C" {
+#include "crc.h"
+#include "dynamic_keymap.h"
+#include "raw_hid.h"
+#include "via.h"
+
+void advance_time(uint32_t ms);
+
+static std::vector<std::vector<uint8_t>> sent_reports;
+
+void raw_hid_send(uint8_t *data, uint8_t length) {
+    sent_reports.emplace_back(data, data + length);
+}
+
+// Number of reports raw_hid_try_send() refuses, as when the host is not reading
+static int try_send_failures = 0;
+
+bool raw_hid_try_send(uint8_t *data, uint8_t length) {
+    if (try_send_failures > 0) {
+        try_send_failures--;
+        return false;
+    }
+    raw_hid_send(data, length);
+    return true;
+}
+
+// The test keymap has a single layer
+uint8_t keymap_layer_count(void) {
+    return 1;
+}
+}
+
+#define REPORT_SIZE 32
+#define PAYLOAD_SIZE (REPORT_SIZE - 2)
+#define ERASED 0xEE
+
+class ViaBulk : public TestFixture {
+   public:
+    void SetUp() override {
+        sent_reports.clear();
+        std::vector<uint8_t> erased(dynamic_keymap_get_buffer_size(), ERASED);
+        dynamic_keymap_set_buffer(0, erased.size(), erased.data());
+    }
+
+    // Feeds one report to VIA, returns the reply if there was one
+    std::vector<uint8_t> receive(std::vector<uint8_t> report) {
+        report.resize(REPORT_SIZE);
+        sent_reports.clear();
+        raw_hid_receive(report.data(), report.size());
+        EXPECT_LE(sent_reports.size(), 1);
+        return sent_reports.empty() ? std::vector<uint8_t>{} : sent_reports.back();
+    }
+
+    std::vector<uint8_t> start(uint16_t offset, uint16_t size) {
+        return receive({id_dynamic_keymap_bulk_start, (uint8_t)(offset >> 8), (uint8_t)(offset & 0xFF), (uint8_t)(size >> 8), (uint8_t)(size & 0xFF)});
+    }
+
+    void data(uint8_t sequence, const std::vector<uint8_t> &payload) {
+        std::vector<uint8_t> report = {id_dynamic_keymap_bulk_data, sequence};
+        report.insert(report.end(), payload.begin(), payload.end());
+        EXPECT_TRUE(receive(report).empty()) << "data packets get no reply";
+    }
+
+    std::vector<uint8_t> end(uint8_t crc) {
+        return receive({id_dynamic_keymap_bulk_end, crc});
+    }
+
+    static std::vector<uint8_t> test_data(uint16_t size) {
+        std::vector<uint8_t> data(size);
+        for (uint16_t i = 0; i < size; i++) {
+            data[i] = i * 7 + 1;
+        }
+        return data;
+    }
+
+    static std::vector<uint8_t> chunk(const std::vector<uint8_t> &data, uint8_t sequence) {
+        auto first = data.begin() + std::min<size_t>(sequence * PAYLOAD_SIZE, data.size());
+        auto last  = data.begin() + std::min<size_t>((sequence + 1) * PAYLOAD_SIZE, data.size());
+        return std::vector<uint8_t>(first, last);
+    }
+
+    static std::vector<uint8_t> eeprom(uint16_t offset, uint16_t size) {
+        std::vector<uint8_t> buffer(size);
+        dynamic_keymap_get_buffer(offset, size, buffer.data());
+        return buffer;
+    }
+};
+
+TEST_F(ViaBulk, WritesAtUnalignedOffset) {
+    TestDriver driver;
+    const uint16_t offset = 5;
+    auto           bytes  = test_data(100);
+
+    auto reply = start(offset, bytes.size());
+    EXPECT_EQ(reply[0], id_dynamic_keymap_bulk_start);
+    EXPECT_EQ(reply[1], via_bulk_ok);
+    EXPECT_EQ(reply[2], PAYLOAD_SIZE);
+
+    // The first page ends at the first page boundary after the offset, the rest waits in RAM
+    data(0, chunk(bytes, 0));
+    const uint16_t first_page = VIA_BULK_PAGE_SIZE - offset % VIA_BULK_PAGE_SIZE;
+    EXPECT_EQ(eeprom(offset, first_page), std::vector<uint8_t>(bytes.begin(), bytes.begin() + first_page));
+    EXPECT_EQ(eeprom(offset + first_page, PAYLOAD_SIZE - first_page), std::vector<uint8_t>(PAYLOAD_SIZE - first_page, ERASED));
+
+    for (uint8_t sequence = 1; sequence * PAYLOAD_SIZE < bytes.size(); sequence++) {
+        data(sequence, chunk(bytes, sequence));
+    }
+    // The last page is written on the end report
+    reply = end(crc8(bytes.data(), bytes.size()));
+    EXPECT_EQ(reply[0], id_dynamic_keymap_bulk_end);
+    EXPECT_EQ(reply[1], via_bulk_ok);
+    EXPECT_EQ(reply[2], crc8(bytes.data(), bytes.size()));
+    EXPECT_EQ((reply[3] << 8) | reply[4], bytes.size());
+
+    EXPECT_EQ(eeprom(offset, bytes.size()), bytes);
+    EXPECT_EQ(eeprom(0, offset), std::vector<uint8_t>(offset, ERASED));
+    EXPECT_EQ(eeprom(offset + bytes.size(), 10), std::vector<uint8_t>(10, ERASED));
+}
+
+TEST_F(ViaBulk, WritesTheWholeBuffer) {
+    TestDriver driver;
+    auto       bytes = test_data(dynamic_keymap_get_buffer_size());
+
+    EXPECT_EQ(start(0, bytes.size())[1], via_bulk_ok);
+    for (uint8_t sequence = 0; sequence * PAYLOAD_SIZE < bytes.size(); sequence++) {
+        data(sequence, chunk(bytes, sequence));
+    }
+    EXPECT_EQ(end(crc8(bytes.data(), bytes.size()))[1], via_bulk_ok);
+
+    EXPECT_EQ(eeprom(0, bytes.size()), bytes);
+}
+
+TEST_F(ViaBulk, LostPacketIsReported) {
+    TestDriver driver;
+    const uint16_t offset = 40;
+    auto           bytes  = test_data(90);
+
+    EXPECT_EQ(start(offset, bytes.size())[1], via_bulk_ok);
+    data(0, chunk(bytes, 0));
+    data(2, chunk(bytes, 2));
+    data(1, chunk(bytes, 1));
+    auto reply = end(crc8(bytes.data(), bytes.size()));
+    EXPECT_EQ(reply[1], via_bulk_lost_packet);
+    EXPECT_EQ((reply[3] << 8) | reply[4], PAYLOAD_SIZE);
+
+    // Only the data before the gap is written
+    EXPECT_EQ(eeprom(offset, PAYLOAD_SIZE), chunk(bytes, 0));
+    EXPECT_EQ(eeprom(offset + PAYLOAD_SIZE, bytes.size() - PAYLOAD_SIZE), std::vector<uint8_t>(bytes.size() - PAYLOAD_SIZE, ERASED));
+}
+
+TEST_F(ViaBulk, MissingDataIsReportedAsLost) {
+    TestDriver driver;
+    auto       bytes = test_data(50);
+
+    EXPECT_EQ(start(0, bytes.size())[1], via_bulk_ok);
+    data(0, chunk(bytes, 0));
+    auto reply = end(crc8(bytes.data(), bytes.size()));
+    EXPECT_EQ(reply[1], via_bulk_lost_packet);
+    EXPECT_EQ((reply[3] << 8) | reply[4], PAYLOAD_SIZE);
+}
+
+TEST_F(ViaBulk, CrcMismatchIsReported) {
+    TestDriver driver;
+    const uint16_t offset = 17;
+    auto           bytes  = test_data(64);
+    const uint8_t  crc    = crc8(bytes.data(), bytes.size());
+
+    EXPECT_EQ(start(offset, bytes.size())[1], via_bulk_ok);
+    for (uint8_t sequence = 0; sequence * PAYLOAD_SIZE < bytes.size(); sequence++) {
+        data(sequence, chunk(bytes, sequence));
+    }
+    auto reply = end(crc ^ 0x5A);
+    EXPECT_EQ(reply[1], via_bulk_crc_mismatch);
+    EXPECT_EQ(reply[2], crc);
+    EXPECT_EQ((reply[3] << 8) | reply[4], bytes.size());
+
+    // Data is written as it arrives, the host is expected to send it again
+    EXPECT_EQ(eeprom(offset, bytes.size()), bytes);
+}
+
+TEST_F(ViaBulk, RangeOutsideTheBufferIsRejected) {
+    TestDriver driver;
+    const uint16_t size = dynamic_keymap_get_buffer_size();
+
+    EXPECT_EQ(start(size - 10, 11)[1], via_bulk_bad_range);
+    EXPECT_EQ(start(0, 0)[1], via_bulk_bad_range);
+    EXPECT_EQ(start(size, 1)[1], via_bulk_bad_range);
+
+    // Data without an accepted start is ignored
+    data(0, test_data(PAYLOAD_SIZE));
+    EXPECT_EQ(end(0)[1], via_bulk_lost_packet);
+    EXPECT_EQ(eeprom(0, size), std::vector<uint8_t>(size, ERASED));
+}
+
+#define ROW_BYTES ((MATRIX_COLS + 7) / 8)
+// Rows that fit in one id_switch_matrix_delta report, after its 7 byte header
+#define ROWS_PER_REPORT ((REPORT_SIZE - 7) / (1 + ROW_BYTES))
+
+class ViaMatrixStream : public TestFixture {
+   public:
+    void SetUp() override {
+        try_send_failures = 0;
+        clear_all_keys();
+        set_stream(true);
+    }
+
+    void TearDown() override {
+        set_stream(false);
+        clear_all_keys();
+    }
+
+    void set_stream(bool enable) {
+        uint8_t report[REPORT_SIZE] = {id_set_keyboard_value, id_switch_matrix_stream, enable};
+        raw_hid_receive(report, sizeof(report));
+        EXPECT_EQ(report[3], ROW_BYTES);
+        EXPECT_EQ(report[4], MATRIX_ROWS);
+    }
+
+    // Runs the stream task one interval later, returns the reports it sent
+    std::vector<std::vector<uint8_t>> stream_task() {
+        advance_time(VIA_MATRIX_STREAM_INTERVAL);
+        sent_reports.clear();
+        via_matrix_stream_task();
+        return sent_reports;
+    }
+
+    static void expect_row(const std::vector<uint8_t> &report, uint8_t index, uint8_t row, matrix_row_t value) {
+        const uint8_t *entry = &report[7 + index * (1 + ROW_BYTES)];
+        EXPECT_EQ(entry[0], row);
+        EXPECT_EQ((entry[1] << 8) | entry[2], value);
+    }
+};
+
+TEST_F(ViaMatrixStream, RowsThatDoNotFitFollowInTheNextReport) {
+    TestDriver driver;
+    static_assert(MATRIX_ROWS > ROWS_PER_REPORT, "the matrix must not fit in one report");
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        press_key(row % MATRIX_COLS, row);
+    }
+
+    auto reports = stream_task();
+    ASSERT_EQ(reports.size(), 1);
+    EXPECT_EQ(reports[0][0], id_switch_matrix_delta);
+    EXPECT_EQ(reports[0][1], 0);
+    EXPECT_EQ(reports[0][6], ROWS_PER_REPORT | 0x80) << "more rows follow";
+    for (uint8_t i = 0; i < ROWS_PER_REPORT; i++) {
+        expect_row(reports[0], i, i, 1 << (i % MATRIX_COLS));
+    }
+
+    reports = stream_task();
+    ASSERT_EQ(reports.size(), 1);
+    EXPECT_EQ(reports[0][1], 1);
+    EXPECT_EQ(reports[0][6], MATRIX_ROWS - ROWS_PER_REPORT);
+    for (uint8_t i = 0; i < MATRIX_ROWS - ROWS_PER_REPORT; i++) {
+        expect_row(reports[0], i, ROWS_PER_REPORT + i, 1 << ((ROWS_PER_REPORT + i) % MATRIX_COLS));
+    }
+
+    EXPECT_TRUE(stream_task().empty()) << "nothing changed since";
+}
+
+TEST_F(ViaMatrixStream, FailedSendIsRetried) {
+    TestDriver driver;
+    press_key(3, 2);
+
+    try_send_failures = 1;
+    EXPECT_TRUE(stream_task().empty());
+
+    // The change is still pending, under the same sequence number
+    auto reports = stream_task();
+    ASSERT_EQ(reports.size(), 1);
+    EXPECT_EQ(reports[0][1], 0);
+    EXPECT_EQ(reports[0][6], 1);
+    expect_row(reports[0], 0, 2, 1 << 3);
+
+    release_key(3, 2);
+    reports = stream_task();
+    ASSERT_EQ(reports.size(), 1);
+    EXPECT_EQ(reports[0][1], 1);
+    expect_row(reports[0], 0, 2, 0);
+}
@@ -56,6 +56,7 @@
 #include <string.h>
 #include "report.h"
 #include "usb_descriptor_common.h"
+#include "timer.h"
 
 //***************************************************************************
 // KBD
@@ -644,7 +645,7 @@ static bool udi_hid_raw_b_report_valid;
 COMPILER_WORD_ALIGNED
 uint8_t udi_hid_raw_report[UDI_HID_RAW_REPORT_SIZE];
 
-static bool udi_hid_raw_b_report_trans_ongoing;
+static volatile bool udi_hid_raw_b_report_trans_ongoing;
 
 COMPILER_WORD_ALIGNED
 static uint8_t udi_hid_raw_report_trans[UDI_HID_RAW_REPORT_SIZE];
@@ -732,11 +733,20 @@ static void udi_hid_raw_report_sent(udd_ep_status_t status, iram_size_t nb_sent,
 
 static void udi_hid_raw_setreport_valid(void) {}
 
-void raw_hid_send(uint8_t *data, uint8_t length) {
+bool raw_hid_try_send(uint8_t *data, uint8_t length) {
     if (main_b_raw_enable && !udi_hid_raw_b_report_trans_ongoing && length == UDI_HID_RAW_REPORT_SIZE) {
         memcpy(udi_hid_raw_report, data, UDI_HID_RAW_REPORT_SIZE);
-        udi_hid_raw_send_report();
+        return udi_hid_raw_send_report();
+    }
+    return false;
+}
+
+// Replies wait up to 10ms for a report pushed just before, e.g. by via_matrix_stream_task(), to be read
+void raw_hid_send(uint8_t *data, uint8_t length) {
+    uint32_t start = timer_read32();
+    while (udi_hid_raw_b_report_trans_ongoing && timer_elapsed32(start) < 10) {
     }
+    raw_hid_try_send(data, length);
 }
 
 bool udi_hid_raw_receive_report(void) {
@@ -44,6 +44,10 @@
 #include "usb_descriptor.h"
 #include "usb_driver.h"
 
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
+
 #ifdef NKRO_ENABLE
 #    include "keycode_config.h"
 
@@ -106,6 +110,7 @@ uint8_t extra_report_blank[3] = {0};
 #define HID_SET_REPORT 0x09
 #define HID_SET_IDLE 0x0A
 #define HID_SET_PROTOCOL 0x0B
+#define HID_REPORT_TYPE_FEATURE 0x03
 
 /*
  * Handles the GET_DESCRIPTOR callback
@@ -505,11 +510,15 @@ static void usb_event_cb(USBDriver *usbp, usbevent_t event) {
             }
             usb_event_queue_enqueue(USB_EVENT_CONFIGURED);
             return;
+        case USB_EVENT_RESET:
+#ifdef MOUSE_FEATURE_INTERFACE
+            /* The host selects the resolution multiplier again after a reset */
+            host_mouse_set_resolution_multiplier(0);
+#endif
+            /* Falls into.*/
         case USB_EVENT_SUSPEND:
             /* Falls into.*/
         case USB_EVENT_UNCONFIGURED:
-            /* Falls into.*/
-        case USB_EVENT_RESET:
             usb_event_queue_enqueue(event);
             for (int i = 0; i < NUM_USB_DRIVERS; i++) {
                 chSysLockFromISR();
@@ -570,6 +579,14 @@ static void    set_led_transfer_cb(USBDriver *usbp) {
     }
 }
 
+#ifdef MOUSE_FEATURE_INTERFACE
+static uint8_t get_feature_buf[MOUSE_FEATURE_REPORT_SIZE] __attribute__((aligned(4)));
+static uint8_t set_feature_buf[MOUSE_FEATURE_REPORT_SIZE] __attribute__((aligned(4)));
+static void    set_mouse_feature_transfer_cb(USBDriver *usbp) {
+    host_mouse_set_feature_report(set_feature_buf, MIN(usbp->setup[6], sizeof(set_feature_buf))); /* LSB(wLength) */
+}
+#endif
+
 /* Callback for SETUP request on the endpoint 0 (control) */
 static bool usb_request_hook_cb(USBDriver *usbp) {
     const USBDescriptor *dp;
@@ -587,6 +604,12 @@ static bool usb_request_hook_cb(USBDriver *usbp) {
             case USB_RTYPE_DIR_DEV2HOST:
                 switch (usbp->setup[1]) { /* bRequest */
                     case HID_GET_REPORT:
+#ifdef MOUSE_FEATURE_INTERFACE
+                        if ((usbp->setup[3] == HID_REPORT_TYPE_FEATURE) && (usbp->setup[4] == MOUSE_FEATURE_INTERFACE)) { /* MSB(wValue), LSB(wIndex) */
+                            usbSetupTransfer(usbp, get_feature_buf, host_mouse_get_feature_report(get_feature_buf), NULL);
+                            return TRUE;
+                        }
+#endif
                         switch (usbp->setup[4]) { /* LSB(wIndex) (check MSB==0?) */
                             case KEYBOARD_INTERFACE:
                                 usbSetupTransfer(usbp, (uint8_t *)&keyboard_report_sent, sizeof(keyboard_report_sent), NULL);
@@ -624,6 +647,12 @@ static bool usb_request_hook_cb(USBDriver *usbp) {
             case USB_RTYPE_DIR_HOST2DEV:
                 switch (usbp->setup[1]) { /* bRequest */
                     case HID_SET_REPORT:
+#ifdef MOUSE_FEATURE_INTERFACE
+                        if ((usbp->setup[3] == HID_REPORT_TYPE_FEATURE) && (usbp->setup[4] == MOUSE_FEATURE_INTERFACE)) { /* MSB(wValue), LSB(wIndex) */
+                            usbSetupTransfer(usbp, set_feature_buf, sizeof(set_feature_buf), set_mouse_feature_transfer_cb);
+                            return TRUE;
+                        }
+#endif
                         switch (usbp->setup[4]) { /* LSB(wIndex) (check MSB==0?) */
                             case KEYBOARD_INTERFACE:
 #if defined(SHARED_EP_ENABLE) && !defined(KEYBOARD_SHARED_EP)
@@ -770,9 +799,11 @@ __attribute__((weak)) void restart_usb_driver(USBDriver *usbp) {
 /* keyboard IN callback hander (a kbd report has made it IN) */
 #ifndef KEYBOARD_SHARED_EP
 void kbd_in_cb(USBDriver *usbp, usbep_t ep) {
-    /* STUB */
     (void)usbp;
     (void)ep;
+#    ifdef LATENCY_TRACE_ENABLE
+    latency_trace_mark(LATENCY_STAGE_USB_IN);
+#    endif
 }
 #endif
 
@@ -935,9 +966,11 @@ void send_mouse(report_mouse_t *report) {
 #ifdef SHARED_EP_ENABLE
 /* shared IN callback hander */
 void shared_in_cb(USBDriver *usbp, usbep_t ep) {
-    /* STUB */
     (void)usbp;
     (void)ep;
+#    if defined(LATENCY_TRACE_ENABLE) && (defined(KEYBOARD_SHARED_EP) || defined(NKRO_ENABLE))
+    latency_trace_mark(LATENCY_STAGE_USB_IN);
+#    endif
 }
 #endif
 
@@ -1096,6 +1129,14 @@ void raw_hid_send(uint8_t *data, uint8_t length) {
     chnWrite(&drivers.raw_driver.driver, data, length);
 }
 
+bool raw_hid_try_send(uint8_t *data, uint8_t length) {
+    if (length != RAW_EPSIZE) {
+        return false;
+    }
+    // Reports fill exactly one queue buffer, so this either queues all of it or nothing
+    return chnWriteTimeout(&drivers.raw_driver.driver, data, length, TIME_IMMEDIATE) == length;
+}
+
 __attribute__((weak)) void raw_hid_receive(uint8_t *data, uint8_t length) {
     // Users should #include "raw_hid.h" in their own code
     // and implement this function there. Leave this as weak linkage
@@ -1146,6 +1187,10 @@ void virtser_send(const uint8_t byte) {
     chnWrite(&drivers.serial_driver.driver, &byte, 1);
 }
 
+void virtser_send_buffer(const uint8_t *data, uint8_t length) {
+    chnWrite(&drivers.serial_driver.driver, data, length);
+}
+
 __attribute__((weak)) void virtser_recv(uint8_t c) {
     // Ignore by default
 }
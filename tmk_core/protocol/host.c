@@ -23,6 +23,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "util.h"
 #include "debug.h"
 #include "digitizer.h"
+#include "action_util.h"
+
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
 
 #ifdef NKRO_ENABLE
 #    include "keycode_config.h"
@@ -33,6 +38,9 @@ static host_driver_t *driver;
 static uint16_t       last_system_report              = 0;
 static uint16_t       last_consumer_report            = 0;
 static uint32_t       last_programmable_button_report = 0;
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+static volatile uint8_t mouse_resolution_multiplier = 0;
+#endif
 
 void host_set_driver(host_driver_t *d) {
     driver = d;
@@ -61,6 +69,39 @@ led_t host_keyboard_led_state(void) {
     return (led_t)host_keyboard_leds();
 }
 
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+/* Feature report byte the host last wrote to the mouse, 0 after a USB reset.
+ * Set from the USB control request handlers, which may run in interrupt context. */
+void host_mouse_set_resolution_multiplier(uint8_t feature) {
+    mouse_resolution_multiplier = feature;
+}
+
+uint8_t host_mouse_resolution_multiplier(void) {
+    return mouse_resolution_multiplier;
+}
+
+/* Takes the mouse feature report of a SET_REPORT(Feature) request. */
+void host_mouse_set_feature_report(const uint8_t *report, uint8_t len) {
+#    ifdef MOUSE_SHARED_EP
+    if (len < MOUSE_FEATURE_REPORT_SIZE || report[0] != REPORT_ID_MOUSE) return;
+    mouse_resolution_multiplier = report[1];
+#    else
+    if (len < MOUSE_FEATURE_REPORT_SIZE) return;
+    mouse_resolution_multiplier = report[0];
+#    endif
+}
+
+/* Fills in the mouse feature report for a GET_REPORT(Feature) request, returns its size. */
+uint8_t host_mouse_get_feature_report(uint8_t *report) {
+    uint8_t len = 0;
+#    ifdef MOUSE_SHARED_EP
+    report[len++] = REPORT_ID_MOUSE;
+#    endif
+    report[len++] = mouse_resolution_multiplier;
+    return len;
+}
+#endif
+
 /* send report */
 void host_keyboard_send(report_keyboard_t *report) {
     if (!driver) return;
@@ -80,6 +121,10 @@ void host_keyboard_send(report_keyboard_t *report) {
     }
     (*driver->send_keyboard)(report);
 
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_mark(LATENCY_STAGE_HOST_SEND);
+#endif
+
     if (debug_keyboard) {
         dprint("keyboard_report: ");
         for (uint8_t i = 0; i < KEYBOARD_REPORT_SIZE; i++) {
@@ -91,6 +136,8 @@ void host_keyboard_send(report_keyboard_t *report) {
 
 void host_mouse_send(report_mouse_t *report) {
     if (!driver) return;
+    // A keyboard report held back by a batch goes first, so reports stay in order
+    flush_keyboard_report();
 #ifdef MOUSE_SHARED_EP
     report->report_id = REPORT_ID_MOUSE;
 #endif
@@ -107,6 +154,7 @@ void host_system_send(uint16_t report) {
     last_system_report = report;
 
     if (!driver) return;
+    flush_keyboard_report();
     (*driver->send_system)(report);
 }
 
@@ -115,11 +163,13 @@ void host_consumer_send(uint16_t report) {
     last_consumer_report = report;
 
     if (!driver) return;
+    flush_keyboard_report();
     (*driver->send_consumer)(report);
 }
 
 void host_digitizer_send(digitizer_t *digitizer) {
     if (!driver) return;
+    flush_keyboard_report();
 
     report_digitizer_t report = {
 #ifdef DIGITIZER_SHARED_EP
@@ -141,6 +191,7 @@ void host_programmable_button_send(uint32_t report) {
     last_programmable_button_report = report;
 
     if (!driver) return;
+    flush_keyboard_report();
     (*driver->send_programmable_button)(report);
 }
 
@@ -53,6 +53,13 @@ uint16_t host_last_system_report(void);
 uint16_t host_last_consumer_report(void);
 uint32_t host_last_programmable_button_report(void);
 
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+void    host_mouse_set_resolution_multiplier(uint8_t feature);
+uint8_t host_mouse_resolution_multiplier(void);
+void    host_mouse_set_feature_report(const uint8_t *report, uint8_t len);
+uint8_t host_mouse_get_feature_report(uint8_t *report);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
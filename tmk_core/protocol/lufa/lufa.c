@@ -137,18 +137,20 @@ USB_ClassInfo_CDC_Device_t cdc_device = {
 
 /** \brief Raw HID Send
  *
- * FIXME: Needs doc
+ * Waits up to timeout * 40us for the host to be ready, dropping the report otherwise.
  */
-void raw_hid_send(uint8_t *data, uint8_t length) {
+static bool raw_hid_send_report(uint8_t *data, uint8_t length, uint8_t timeout) {
     // TODO: implement variable size packet
     if (length != RAW_EPSIZE) {
-        return;
+        return false;
     }
 
     if (USB_DeviceState != DEVICE_STATE_Configured) {
-        return;
+        return false;
     }
 
+    bool sent = false;
+
     // TODO: decide if we allow calls to raw_hid_send() in the middle
     // of other endpoint usage.
     uint8_t ep = Endpoint_GetCurrentEndpoint();
@@ -156,14 +158,28 @@ void raw_hid_send(uint8_t *data, uint8_t length) {
     Endpoint_SelectEndpoint(RAW_IN_EPNUM);
 
     // Check to see if the host is ready to accept another packet
+    while (!Endpoint_IsINReady() && timeout--) {
+        _delay_us(40);
+    }
     if (Endpoint_IsINReady()) {
         // Write data
         Endpoint_Write_Stream_LE(data, RAW_EPSIZE, NULL);
         // Finalize the stream transfer to send the last packet
         Endpoint_ClearIN();
+        sent = true;
     }
 
     Endpoint_SelectEndpoint(ep);
+    return sent;
+}
+
+bool raw_hid_try_send(uint8_t *data, uint8_t length) {
+    return raw_hid_send_report(data, length, 0);
+}
+
+// Replies wait for a report pushed just before, e.g. by via_matrix_stream_task(), to be read
+void raw_hid_send(uint8_t *data, uint8_t length) {
+    raw_hid_send_report(data, length, 255);
 }
 
 /** \brief Raw HID Receive
@@ -380,6 +396,10 @@ void EVENT_USB_Device_Disconnect(void) {
 void EVENT_USB_Device_Reset(void) {
     print("[R]");
     usb_device_state_set_reset();
+#ifdef MOUSE_FEATURE_INTERFACE
+    // The host selects the resolution multiplier again after a reset
+    host_mouse_set_resolution_multiplier(0);
+#endif
 }
 
 /** \brief Event USB Device Connect
@@ -541,6 +561,15 @@ void EVENT_USB_Device_ControlRequest(void) {
                         break;
                 }
 
+#ifdef MOUSE_FEATURE_INTERFACE
+                // Report type in MSB(wValue), 3 is Feature
+                if ((USB_ControlRequest.wValue >> 8) == 0x03 && USB_ControlRequest.wIndex == MOUSE_FEATURE_INTERFACE) {
+                    static uint8_t mouse_feature_report[MOUSE_FEATURE_REPORT_SIZE];
+                    ReportSize = host_mouse_get_feature_report(mouse_feature_report);
+                    ReportData = mouse_feature_report;
+                }
+#endif
+
                 /* Write the report data to the control endpoint */
                 Endpoint_Write_Control_Stream_LE(ReportData, ReportSize);
                 Endpoint_ClearOUT();
@@ -549,6 +578,27 @@ void EVENT_USB_Device_ControlRequest(void) {
             break;
         case HID_REQ_SetReport:
             if (USB_ControlRequest.bmRequestType == (REQDIR_HOSTTODEVICE | REQTYPE_CLASS | REQREC_INTERFACE)) {
+#ifdef MOUSE_FEATURE_INTERFACE
+                // Report type in MSB(wValue), 3 is Feature
+                if ((USB_ControlRequest.wValue >> 8) == 0x03 && USB_ControlRequest.wIndex == MOUSE_FEATURE_INTERFACE) {
+                    Endpoint_ClearSETUP();
+
+                    while (!(Endpoint_IsOUTReceived())) {
+                        if (USB_DeviceState == DEVICE_STATE_Unattached) return;
+                    }
+
+                    uint8_t report[MOUSE_FEATURE_REPORT_SIZE];
+                    uint8_t len = 0;
+                    while (len < sizeof(report) && Endpoint_BytesInEndpoint()) {
+                        report[len++] = Endpoint_Read_8();
+                    }
+                    host_mouse_set_feature_report(report, len);
+
+                    Endpoint_ClearOUT();
+                    Endpoint_ClearStatusStage();
+                    break;
+                }
+#endif
                 // Interface
                 switch (USB_ControlRequest.wIndex) {
                     case KEYBOARD_INTERFACE:
@@ -960,6 +1010,37 @@ void virtser_send(const uint8_t byte) {
         Endpoint_SelectEndpoint(ep);
     }
 }
+
+/** \brief Virtual Serial Send Buffer
+ *
+ * Writes all bytes into the IN endpoint before flushing, so they go out in as few packets as possible
+ */
+void virtser_send_buffer(const uint8_t *data, uint8_t length) {
+    uint8_t timeout = 255;
+    uint8_t ep      = Endpoint_GetCurrentEndpoint();
+
+    if (cdc_device.State.ControlLineStates.HostToDevice & CDC_CONTROL_LINE_OUT_DTR) {
+        /* IN packet */
+        Endpoint_SelectEndpoint(cdc_device.Config.DataINEndpoint.Address);
+
+        if (!Endpoint_IsEnabled() || !Endpoint_IsConfigured()) {
+            Endpoint_SelectEndpoint(ep);
+            return;
+        }
+
+        while (timeout-- && !Endpoint_IsReadWriteAllowed())
+            _delay_us(40);
+
+        Endpoint_Write_Stream_LE(data, length, NULL);
+        CDC_Device_Flush(&cdc_device);
+
+        if (Endpoint_IsINReady()) {
+            Endpoint_ClearIN();
+        }
+
+        Endpoint_SelectEndpoint(ep);
+    }
+}
 #endif
 
 void send_digitizer(report_digitizer_t *report) {
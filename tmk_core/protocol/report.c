@@ -104,6 +104,33 @@ bool is_key_pressed(report_keyboard_t* keyboard_report, uint8_t key) {
     return false;
 }
 
+/** \brief Checks if keys are pressed again
+ *
+ * Returns true if next presses a key or modifier that was held in previous and released in current, otherwise false
+ */
+bool is_key_repressed(report_keyboard_t* previous, report_keyboard_t* current, report_keyboard_t* next) {
+    if (previous->mods & ~current->mods & next->mods) {
+        return true;
+    }
+#ifdef NKRO_ENABLE
+    if (keyboard_protocol && keymap_config.nkro) {
+        for (uint8_t i = 0; i < KEYBOARD_REPORT_BITS; i++) {
+            if (previous->nkro.bits[i] & ~current->nkro.bits[i] & next->nkro.bits[i]) {
+                return true;
+            }
+        }
+        return false;
+    }
+#endif
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        uint8_t key = previous->keys[i];
+        if (key != KC_NO && !is_key_pressed(current, key) && is_key_pressed(next, key)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 /** \brief add key byte
  *
  * FIXME: Needs doc
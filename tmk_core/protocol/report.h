@@ -207,6 +207,25 @@ typedef int16_t mouse_xy_report_t;
 typedef int8_t mouse_xy_report_t;
 #endif
 
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+// Wheel counts per detent once the host has enabled the resolution multiplier
+#    ifndef POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER
+#        define POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER 120
+#    endif
+#    if POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER < 1 || POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER > 32767
+#        error POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER must be between 1 and 32767
+#    endif
+// Resolution multiplier fields of the mouse feature report
+#    define MOUSE_RESOLUTION_MULTIPLIER_V 0x03
+#    define MOUSE_RESOLUTION_MULTIPLIER_H 0x0C
+// Size of the mouse feature report, with its report ID if the mouse has one
+#    ifdef MOUSE_SHARED_EP
+#        define MOUSE_FEATURE_REPORT_SIZE 2
+#    else
+#        define MOUSE_FEATURE_REPORT_SIZE 1
+#    endif
+#endif
+
 typedef struct {
 #ifdef MOUSE_SHARED_EP
     uint8_t report_id;
@@ -318,6 +337,7 @@ static inline uint16_t KEYCODE2CONSUMER(uint8_t key) {
 uint8_t has_anykey(report_keyboard_t* keyboard_report);
 uint8_t get_first_key(report_keyboard_t* keyboard_report);
 bool    is_key_pressed(report_keyboard_t* keyboard_report, uint8_t key);
+bool    is_key_repressed(report_keyboard_t* previous, report_keyboard_t* current, report_keyboard_t* next);
 
 void add_key_byte(report_keyboard_t* keyboard_report, uint8_t code);
 void del_key_byte(report_keyboard_t* keyboard_report, uint8_t code);
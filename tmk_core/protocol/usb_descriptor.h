@@ -197,6 +197,15 @@ enum usb_interfaces {
     TOTAL_INTERFACES
 };
 
+// Interface that receives the mouse resolution multiplier feature report
+#if defined(MOUSE_ENABLE) && defined(POINTING_DEVICE_HIRES_SCROLL_ENABLE)
+#    ifdef MOUSE_SHARED_EP
+#        define MOUSE_FEATURE_INTERFACE SHARED_INTERFACE
+#    else
+#        define MOUSE_FEATURE_INTERFACE MOUSE_INTERFACE
+#    endif
+#endif
+
 #define NEXT_EPNUM __COUNTER__
 
 /*
@@ -131,6 +131,15 @@ void vusb_transfer_keyboard(void) {
 static uint8_t raw_output_buffer[RAW_BUFFER_SIZE];
 static uint8_t raw_output_received_bytes = 0;
 
+bool raw_hid_try_send(uint8_t *data, uint8_t length) {
+    // Once the first chunk is taken, the host is reading and the rest follows shortly
+    if (length != RAW_BUFFER_SIZE || !usbInterruptIsReady4()) {
+        return false;
+    }
+    raw_hid_send(data, length);
+    return true;
+}
+
 void raw_hid_send(uint8_t *data, uint8_t length) {
     if (length != RAW_BUFFER_SIZE) {
         return;
@@ -324,7 +333,7 @@ static void send_programmable_button(uint32_t data) {
  *------------------------------------------------------------------*/
 static struct {
     uint16_t len;
-    enum { NONE, SET_LED } kind;
+    enum { NONE, SET_LED, SET_MOUSE_FEATURE } kind;
 } last_req;
 
 usbMsgLen_t usbFunctionSetup(uchar data[8]) {
@@ -337,6 +346,15 @@ usbMsgLen_t usbFunctionSetup(uchar data[8]) {
                 usbMsgPtr = (usbMsgPtr_t)&keyboard_report_sent;
                 return sizeof(keyboard_report_sent);
             }
+#if defined(MOUSE_ENABLE) && defined(POINTING_DEVICE_HIRES_SCROLL_ENABLE)
+            // Report Type: 0x03(Feature)/ReportID: mouse && Interface: shared
+            if (rq->wValue.word == (0x0300 | REPORT_ID_MOUSE) && rq->wIndex.word == SHARED_INTERFACE) {
+                static uint8_t mouse_feature_report[MOUSE_FEATURE_REPORT_SIZE];
+                dprint("GET_MOUSE_FEATURE:");
+                usbMsgPtr = (usbMsgPtr_t)mouse_feature_report;
+                return host_mouse_get_feature_report(mouse_feature_report);
+            }
+#endif
         } else if (rq->bRequest == USBRQ_HID_GET_IDLE) {
             dprint("GET_IDLE:");
             usbMsgPtr = (usbMsgPtr_t)&vusb_idle_rate;
@@ -352,6 +370,14 @@ usbMsgLen_t usbFunctionSetup(uchar data[8]) {
                 last_req.kind = SET_LED;
                 last_req.len  = rq->wLength.word;
             }
+#if defined(MOUSE_ENABLE) && defined(POINTING_DEVICE_HIRES_SCROLL_ENABLE)
+            // Report Type: 0x03(Feature)/ReportID: mouse && Interface: shared
+            if (rq->wValue.word == (0x0300 | REPORT_ID_MOUSE) && rq->wIndex.word == SHARED_INTERFACE) {
+                dprint("SET_MOUSE_FEATURE:");
+                last_req.kind = SET_MOUSE_FEATURE;
+                last_req.len  = rq->wLength.word;
+            }
+#endif
             return USB_NO_MSG; // to get data in usbFunctionWrite
         } else {
             dprint("UNKNOWN:");
@@ -375,6 +401,14 @@ uchar usbFunctionWrite(uchar *data, uchar len) {
             last_req.len       = 0;
             return 1;
             break;
+#if defined(MOUSE_ENABLE) && defined(POINTING_DEVICE_HIRES_SCROLL_ENABLE)
+        case SET_MOUSE_FEATURE:
+            dprintf("SET_MOUSE_FEATURE: %02X\n", data[len - 1]);
+            host_mouse_set_feature_report(data, len);
+            last_req.len = 0;
+            return 1;
+            break;
+#endif
         case NONE:
         default:
             return -1;
@@ -506,6 +540,20 @@ const PROGMEM uchar shared_hid_report[] = {
 #    endif
     0x81, 0x06, //     Input (Data, Variable, Relative)
 
+#    ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+    0xA1, 0x02, //     Collection (Logical)
+    // Vertical resolution multiplier (2 bits)
+    0x09, 0x48,                                                                                       //     Usage (Resolution Multiplier)
+    0x15, 0x00,                                                                                       //     Logical Minimum (0)
+    0x25, 0x01,                                                                                       //     Logical Maximum (1)
+    0x35, 0x01,                                                                                       //     Physical Minimum (1)
+    0x46, (POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER & 0xFF), (POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER >> 8), //     Physical Maximum (multiplier)
+    0x95, 0x01,                                                                                       //     Report Count (1)
+    0x75, 0x02,                                                                                       //     Report Size (2)
+    0xB1, 0x02,                                                                                       //     Feature (Data, Variable, Absolute)
+    0x35, 0x00,                                                                                       //     Physical Minimum (0)
+    0x45, 0x00,                                                                                       //     Physical Maximum (0)
+#    endif
     // Vertical wheel (1 byte)
     0x09, 0x38, //     Usage (Wheel)
     0x15, 0x81, //     Logical Minimum (-127)
@@ -513,6 +561,24 @@ const PROGMEM uchar shared_hid_report[] = {
     0x95, 0x01, //     Report Count (1)
     0x75, 0x08, //     Report Size (8)
     0x81, 0x06, //     Input (Data, Variable, Relative)
+#    ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+    0xC0,       //     End Collection
+    0xA1, 0x02, //     Collection (Logical)
+    // Horizontal resolution multiplier (2 bits)
+    0x09, 0x48,                                                                                       //     Usage (Resolution Multiplier)
+    0x15, 0x00,                                                                                       //     Logical Minimum (0)
+    0x25, 0x01,                                                                                       //     Logical Maximum (1)
+    0x35, 0x01,                                                                                       //     Physical Minimum (1)
+    0x46, (POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER & 0xFF), (POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER >> 8), //     Physical Maximum (multiplier)
+    0x95, 0x01,                                                                                       //     Report Count (1)
+    0x75, 0x02,                                                                                       //     Report Size (2)
+    0xB1, 0x02,                                                                                       //     Feature (Data, Variable, Absolute)
+    // Feature padding (4 bits)
+    0x35, 0x00, //     Physical Minimum (0)
+    0x45, 0x00, //     Physical Maximum (0)
+    0x75, 0x04, //     Report Size (4)
+    0xB1, 0x03, //     Feature (Constant)
+#    endif
     // Horizontal wheel (1 byte)
     0x05, 0x0C,       //     Usage Page (Consumer)
     0x0A, 0x38, 0x02, //     Usage (AC Pan)
@@ -521,6 +587,9 @@ const PROGMEM uchar shared_hid_report[] = {
     0x95, 0x01,       //     Report Count (1)
     0x75, 0x08,       //     Report Size (8)
     0x81, 0x06,       //     Input (Data, Variable, Relative)
+#    ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+    0xC0, //     End Collection
+#    endif
     0xC0,             //   End Collection
     0xC0,             // End Collection
 #endif
@@ -944,6 +1013,10 @@ USB_PUBLIC usbMsgLen_t usbFunctionDescriptor(struct usbRequest *rq) {
 
     switch (rq->wValue.bytes[1]) {
         case USBDESCR_DEVICE:
+#if defined(MOUSE_ENABLE) && defined(POINTING_DEVICE_HIRES_SCROLL_ENABLE)
+            // V-USB has no bus reset hook, but the host asks for the device descriptor after every reset
+            host_mouse_set_resolution_multiplier(0);
+#endif
             usbMsgPtr = (usbMsgPtr_t)&usbDeviceDescriptor;
             len       = sizeof(usbDeviceDescriptor_t);
             break;
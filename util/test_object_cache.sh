@@ -0,0 +1,76 @@
+#!/bin/bash
+
+# Copyright 2022 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# Compiler wrapper for the unit test build, which compiles the quantum core
+# once per test suite, each with its own config.h and features.
+#
+# Objects are cached by a hash of their preprocessed source and the compiler
+# flags that are not about preprocessing, so every suite that ends up with the
+# same code for a core source - whatever the path of its config.h, or config
+# options the source does not use - links the object compiled by the first.
+#
+# Usage: test_object_cache.sh <cache dir> <compiler> <arguments>...
+
+set -eEuo pipefail
+
+cache_dir=$1
+shift
+
+# Linking, --version, ...
+case " $* " in
+    *" -c "*) ;;
+    *) exec "$@" ;;
+esac
+
+object=
+dep_file=
+source=
+preprocess_args=()
+compile_args=()
+hashed_args=()
+
+while [ $# -gt 0 ]; do
+    case "$1" in
+        -c) ;;
+        -o) object=$2; shift ;;
+        -MF) dep_file=$2; shift ;;
+        -MMD|-MP) preprocess_args+=("$1") ;;
+        -include) preprocess_args+=("$1" "$2"); shift ;;
+        -I*|-D*|-U*) preprocess_args+=("$1") ;;
+        -*) preprocess_args+=("$1"); compile_args+=("$1"); hashed_args+=("$1") ;;
+        *.c|*.cpp|*.cc) source=$1 ;;
+        *) preprocess_args+=("$1"); compile_args+=("$1"); hashed_args+=("$1") ;;
+    esac
+    shift
+done
+
+case "$source" in
+    *.c) language=cpp-output ;;
+    *.cpp|*.cc) language=c++-cpp-output ;;
+    *) exec "${preprocess_args[@]}" -c ${dep_file:+-MF "$dep_file"} ${source:+"$source"} -o "$object" ;;
+esac
+
+if command -v md5sum >/dev/null; then
+    hash() { md5sum | cut -d' ' -f1; }
+else
+    hash() { md5 -q; }
+fi
+
+preprocessed=$object.i
+"${preprocess_args[@]}" -E ${dep_file:+-MF "$dep_file" -MT "$object"} "$source" -o "$preprocessed"
+
+# Line markers hold the paths of the sources, which are not part of the code
+key=$( (echo "${hashed_args[*]}"; grep -v '^# ' "$preprocessed") | hash)
+cached=$cache_dir/${key:0:2}/$key.o
+
+if [ ! -e "$cached" ]; then
+    "${compile_args[@]}" -c -x "$language" "$preprocessed" -o "$object"
+    mkdir -p "$(dirname "$cached")"
+    cp "$object" "$cached.$$"
+    mv -f "$cached.$$" "$cached"
+else
+    cp "$cached" "$object"
+fi
+rm -f "$preprocessed"